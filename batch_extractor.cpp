@@ -0,0 +1,198 @@
+#include "batch_extractor.h"
+#include "webcam_manager.h"
+#include "gesture_batch.h"
+#include "hand_sample_conversion.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <opencv2/opencv.hpp>
+
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/tasks/cc/core/base_options.h"
+#include "mediapipe/tasks/cc/vision/hand_landmarker/hand_landmarker.h"
+
+namespace {
+using mediapipe::tasks::vision::hand_landmarker::HandLandmarker;
+using mediapipe::tasks::vision::hand_landmarker::HandLandmarkerOptions;
+
+// 마스크 계산: 실시간 경로와 같은 규칙을 배치 분류기로 한 번에 적용합니다.
+void fill_finger_masks(std::vector<TraceFrame>& frames) {
+    std::vector<size_t> with_hand;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (frames[i].sample.has_hand()) with_hand.push_back(i);
+    }
+
+    LandmarkTraceSoA trace;
+    trace.resize(with_hand.size());
+    for (size_t f = 0; f < with_hand.size(); ++f) {
+        const HandSample& sample = frames[with_hand[f]].sample;
+        for (int i = 0; i < HandSample::NUM_LANDMARKS; ++i) {
+            trace.x[i][f] = sample.x(i);
+            trace.y[i][f] = sample.y(i);
+            trace.z[i][f] = sample.z(i);
+        }
+        trace.is_right[f] = sample.handedness == Handedness::RIGHT;
+    }
+
+    std::vector<uint8_t> masks(with_hand.size());
+    classify_raised_fingers_batch(trace, masks.data());
+    for (size_t f = 0; f < with_hand.size(); ++f) frames[with_hand[f]].finger_mask = masks[f];
+}
+}  // namespace
+
+BatchLandmarkExtractor::BatchLandmarkExtractor(const BatchExtractorOptions& options) : options_(options) {}
+
+bool BatchLandmarkExtractor::plan_segments(const std::vector<std::string>& files, std::vector<Segment>& segments) {
+    const int64_t segment_ms = static_cast<int64_t>(std::max(1.0, options_.segment_sec) * 1000);
+    for (int i = 0; i < static_cast<int>(files.size()); ++i) {
+        WebcamManager probe(0, 0, 0, files[i]);
+        if (!probe.initialize()) return false;
+
+        int64_t duration = probe.duration_ms();
+        if (duration <= 0) {
+            // 길이를 모르면 파일 하나를 한 구간으로 처리합니다.
+            segments.push_back({i, 0, std::numeric_limits<int64_t>::max()});
+            continue;
+        }
+        for (int64_t start = 0; start < duration; start += segment_ms) {
+            int64_t end = (start + segment_ms >= duration) ? std::numeric_limits<int64_t>::max() : start + segment_ms;
+            segments.push_back({i, start, end});
+        }
+    }
+    return true;
+}
+
+bool BatchLandmarkExtractor::process_segment(const std::string& file, const Segment& segment, std::vector<TraceFrame>& out) {
+    WebcamManager source(0, 0, 0, file);
+    if (!source.initialize()) return false;
+    if (segment.start_ms > 0 && !source.seek_ms(segment.start_ms)) return false;
+
+    // 구간마다 독립된 인스턴스: VIDEO 모드의 추적 상태와 타임스탬프가 구간 사이에 섞이지 않습니다.
+    auto options = std::make_unique<HandLandmarkerOptions>();
+    options->min_hand_detection_confidence = options_.min_hand_detection_confidence;
+    options->min_tracking_confidence = options_.min_tracking_confidence;
+    options->base_options.delegate = mediapipe::tasks::core::BaseOptions::Delegate::CPU;
+    options->base_options.model_asset_path = options_.model_path;
+    options->running_mode = mediapipe::tasks::vision::core::RunningMode::VIDEO;
+    options->num_hands = 1;
+
+    auto landmarker_result = HandLandmarker::Create(std::move(options));
+    if (!landmarker_result.ok()) {
+        std::cerr << "⛔ HandLandmarker 생성 실패! " << landmarker_result.status() << std::endl;
+        return false;
+    }
+    std::unique_ptr<HandLandmarker> landmarker = std::move(landmarker_result.value());
+
+    cv::Mat frame;
+    int64_t last_timestamp_ms = -1;
+    while (source.grab()) {
+        // 키프레임부터 디코딩하므로 구간 시작 전 프레임은 시각만 보고 RGB 변환 없이 버립니다.
+        // (intra-only 코덱이면 디코딩도 하지 않습니다)
+        int64_t timestamp_ms = 0;
+        if (!source.peek_timestamp_ms(timestamp_ms)) continue;
+        if (timestamp_ms < segment.start_ms) {
+            source.discard();
+            continue;
+        }
+        if (timestamp_ms >= segment.end_ms) break;
+        if (!source.retrieve(frame)) continue;
+
+        auto mp_image_frame = std::make_shared<mediapipe::ImageFrame>(
+            mediapipe::ImageFormat::SRGB, frame.cols, frame.rows);
+        // ImageFrame 은 행마다 정렬 여백이 있으므로 행 간격(WidthStep)을 같이 넘깁니다.
+        cv::Mat destination_mat(frame.rows, frame.cols, CV_8UC3, mp_image_frame->MutablePixelData(),
+                                mp_image_frame->WidthStep());
+        if (options_.mirror) {
+            cv::flip(frame, destination_mat, 1);
+        } else {
+            frame.copyTo(destination_mat);
+        }
+
+        // VIDEO 모드는 타임스탬프가 단조 증가해야 합니다.
+        int64_t detect_timestamp_ms = std::max(timestamp_ms, last_timestamp_ms + 1);
+        last_timestamp_ms = detect_timestamp_ms;
+        auto result = landmarker->DetectForVideo(mediapipe::Image(mp_image_frame), detect_timestamp_ms);
+
+        TraceFrame trace_frame;
+        trace_frame.file_index = segment.file_index;
+        trace_frame.sample.timestamp_ms = timestamp_ms;
+        if (result.ok()) trace_frame.sample = to_hand_sample(*result, timestamp_ms);
+        out.push_back(trace_frame);
+    }
+
+    landmarker->Close();
+    return true;
+}
+
+bool BatchLandmarkExtractor::run(const std::vector<std::string>& files, std::vector<TraceFrame>& out, BatchExtractorStats& stats) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<Segment> segments;
+    if (!plan_segments(files, segments)) return false;
+
+    int num_threads = options_.num_threads > 0 ? options_.num_threads
+                                               : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    num_threads = std::min<int>(num_threads, segments.size());
+
+    // 작업 큐: 스레드마다 다음 구간 번호를 가져가 처리합니다.
+    std::vector<std::vector<TraceFrame>> results(segments.size());
+    std::atomic<size_t> next_segment{0};
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < num_threads; ++t) {
+        workers.emplace_back([&] {
+            for (size_t i = next_segment++; i < segments.size() && !failed; i = next_segment++) {
+                if (!process_segment(files[segments[i].file_index], segments[i], results[i])) failed = true;
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    if (failed) return false;
+
+    // 구간 순서 = 파일/시간 순서
+    out.clear();
+    for (auto& segment_frames : results) {
+        out.insert(out.end(), segment_frames.begin(), segment_frames.end());
+    }
+    fill_finger_masks(out);
+
+    stats.frames = static_cast<int64_t>(out.size());
+    stats.frames_with_hand = std::count_if(out.begin(), out.end(), [](const TraceFrame& f) { return f.sample.has_hand(); });
+    stats.segments = static_cast<int>(segments.size());
+    stats.wall_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool BatchLandmarkExtractor::write_trace(const std::string& path, const std::vector<std::string>& files, const std::vector<TraceFrame>& frames) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "⛔ 트레이스 파일을 열 수 없습니다! (" << path << ")" << std::endl;
+        return false;
+    }
+
+    out << "file,timestamp_ms,hand,finger_mask";
+    for (int i = 0; i < 21; ++i) out << ",x" << i << ",y" << i << ",z" << i;
+    out << "\n";
+
+    for (const TraceFrame& frame : frames) {
+        const HandSample& sample = frame.sample;
+        out << files[frame.file_index] << "," << sample.timestamp_ms << ","
+            << (sample.has_hand() ? handedness_label(sample.handedness) : "None") << ","
+            << static_cast<int>(frame.finger_mask);
+        for (int i = 0; i < HandSample::NUM_LANDMARKS; ++i) {
+            if (sample.has_hand()) {
+                out << "," << sample.x(i) << "," << sample.y(i) << "," << sample.z(i);
+            } else {
+                out << ",,,";
+            }
+        }
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "hand_sample.h"
+#include "model_path.h"
+
+// 녹화 파일에서 손 랜드마크를 오프라인으로 뽑아냅니다. (제스처 튜닝용)
+// 파일마다 구간(segment)으로 나누고, 각 구간을 독립된 VIDEO 모드 HandLandmarker 가 병렬로 처리합니다.
+// 디코딩/변환은 실시간 경로와 같은 WebcamManager 를 사용합니다.
+struct BatchExtractorOptions {
+    std::string model_path = kDefaultModelPath;
+    double segment_sec = 60.0;
+    int num_threads = 0;   // 0 이면 코어 수
+    bool mirror = true;    // 실시간 경로처럼 좌우 반전 후 추론
+    float min_hand_detection_confidence = 0.6f;
+    float min_tracking_confidence = 0.6f;
+};
+
+// 프레임 하나의 결과 (sample.timestamp_ms 는 파일 안에서의 표시 시각)
+struct TraceFrame {
+    int file_index = 0;
+    uint8_t finger_mask = 0;
+    HandSample sample;
+};
+
+struct BatchExtractorStats {
+    int64_t frames = 0;
+    int64_t frames_with_hand = 0;
+    int segments = 0;
+    double wall_sec = 0.0;
+};
+
+class BatchLandmarkExtractor {
+public:
+    explicit BatchLandmarkExtractor(const BatchExtractorOptions& options);
+
+    // 모든 파일을 처리해 결과를 파일/시간 순서로 돌려줍니다.
+    bool run(const std::vector<std::string>& files, std::vector<TraceFrame>& out, BatchExtractorStats& stats);
+
+    // CSV 트레이스로 저장합니다: file,timestamp_ms,hand,finger_mask,x0,y0,z0,...,x20,y20,z20
+    static bool write_trace(const std::string& path, const std::vector<std::string>& files, const std::vector<TraceFrame>& frames);
+
+private:
+    struct Segment {
+        int file_index;
+        int64_t start_ms;
+        int64_t end_ms;
+    };
+
+    bool plan_segments(const std::vector<std::string>& files, std::vector<Segment>& segments);
+    bool process_segment(const std::string& file, const Segment& segment, std::vector<TraceFrame>& out);
+
+    BatchExtractorOptions options_;
+};
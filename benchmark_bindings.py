@@ -0,0 +1,66 @@
+import sys
+import time
+import cv2
+
+import virtual_touch_cc
+from gesture_recognizer import GestureRecognizer
+
+# 같은 녹화 파일로 순수 Python 구현과 C++ 바인딩의 처리 속도를 비교합니다.
+# 사용법: python3 benchmark_bindings.py <녹화 파일>
+# 마우스 입력은 양쪽 모두 끕니다. (순수 Python 은 mouse_event 를 호출하지 않고, C++ 은 inject_mouse=False)
+# 순수 Python 은 프레임마다 동기로 한 번 추론하므로, C++ 쪽도 제출한 프레임이 아니라 실제로 결과가 나온
+# 프레임(results_received) 기준으로 비교합니다. (LIVE_STREAM 그래프가 버린 프레임은 세지 않음)
+
+def bench_python(path):
+    cap = cv2.VideoCapture(path)
+    detector = GestureRecognizer(1920, 1080)
+    frames, hands = 0, 0
+
+    start = time.perf_counter()
+    while True:
+        ret, img = cap.read()
+        if not ret:
+            break
+        img = detector.detect_hands(img)
+        lm_list = detector.get_landmarks(img, draw=False)
+        if len(lm_list) != 0:
+            detector.is_fingers_raised()
+            hands += 1
+        frames += 1
+    elapsed = time.perf_counter() - start
+    cap.release()
+    return frames, hands, elapsed
+
+def bench_cpp(path):
+    options = virtual_touch_cc.Options()
+    options.source = path
+    options.inject_mouse = False
+    options.show_preview = False
+    options.use_gpu = False  # mediapipe python solutions 와 같은 CPU 조건
+    pipeline = virtual_touch_cc.Pipeline(options)
+    if not pipeline.setup():
+        raise RuntimeError("C++ 파이프라인 초기화 실패")
+
+    start = time.perf_counter()
+    pipeline.run()
+    elapsed = time.perf_counter() - start
+    return pipeline.frames_submitted, pipeline.results_received, pipeline.frames_dropped_in_graph, elapsed
+
+def main():
+    if len(sys.argv) < 2:
+        print("사용법: python3 benchmark_bindings.py <녹화 파일>")
+        exit(1)
+    path = sys.argv[1]
+
+    py_frames, py_hands, py_elapsed = bench_python(path)
+    cc_frames, cc_results, cc_dropped, cc_elapsed = bench_cpp(path)
+
+    # inferred: 추론 결과가 나온 프레임 수, fps = inferred / sec
+    print("%-8s %8s %10s %10s %10s" % ("impl", "frames", "inferred", "sec", "fps"))
+    print("%-8s %8d %10d %10.2f %10.1f" % ("python", py_frames, py_frames, py_elapsed, py_frames / py_elapsed))
+    print("%-8s %8d %10d %10.2f %10.1f" % ("c++", cc_frames, cc_results, cc_elapsed, cc_results / cc_elapsed))
+    print("python: 손 감지 %d 프레임 / c++: 그래프에서 버려진 프레임 %d" % (py_hands, cc_dropped))
+    print("speedup: %.2fx" % ((cc_results / cc_elapsed) / (py_frames / py_elapsed)))
+
+if __name__ == "__main__":
+    main()
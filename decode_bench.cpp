@@ -0,0 +1,176 @@
+// decode_bench.cpp
+// 녹화 파일을 리플레이 소스(WebcamManager)로 열어 디코딩 + RGB 변환 처리량을 스레드 설정별로 측정합니다.
+// 추론 없이 grab() → retrieve() 만 반복하므로 캡처 단계가 몇 fps 까지 따라갈 수 있는지 보여줍니다.
+// 사용법: decode_bench --decode_threads=1,0 --convert_threads=1,2,4 clip_720p.mp4 clip_1080p.mkv clip_4k.mp4
+// 녹화 파일이 없으면 웹캠과 같은 MJPEG(yuvj422p) 클립을 해상도별로 만들어서 측정합니다:
+//   decode_bench --generate=1280x720,1920x1080,3840x2160
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "webcam_manager.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/imgutils.h>
+}
+
+ABSL_FLAG(std::vector<std::string>, decode_threads, std::vector<std::string>({"1", "0"}),
+          "측정할 디코딩 스레드 수 목록 (0 = 자동)");
+ABSL_FLAG(std::vector<std::string>, convert_threads, std::vector<std::string>({"1", "2", "4"}),
+          "측정할 RGB 변환 띠 수 목록");
+ABSL_FLAG(bool, frame_threading, true, "디코딩 스레드가 1 보다 많을 때 프레임 스레딩도 켤지");
+ABSL_FLAG(int, warmup_frames, 30, "측정 전에 버릴 프레임 수");
+ABSL_FLAG(int, frames, 600, "측정할 최대 프레임 수 (파일이 짧으면 끝까지)");
+ABSL_FLAG(std::vector<std::string>, generate, {}, "파일 대신 만들어서 측정할 MJPEG 클립 해상도 목록 (예: 1280x720,1920x1080)");
+ABSL_FLAG(std::string, generate_dir, "/tmp", "만든 클립을 저장할 디렉터리");
+
+namespace {
+struct BenchResult {
+    int width = 0;
+    int height = 0;
+    int frames = 0;
+    double seconds = 0.0;
+};
+
+// 프레임마다 움직이는 그라디언트를 MJPEG(yuvj422p, 품질은 웹캠과 비슷하게) 로 인코딩해 mkv 로 씁니다.
+bool write_test_clip(const std::string& path, int width, int height, int num_frames) {
+    const AVCodec* codec = avcodec_find_encoder(AV_CODEC_ID_MJPEG);
+    AVFormatContext* fmt_ctx = nullptr;
+    if (!codec || avformat_alloc_output_context2(&fmt_ctx, nullptr, nullptr, path.c_str()) < 0) return false;
+
+    AVCodecContext* codec_ctx = avcodec_alloc_context3(codec);
+    codec_ctx->width = width;
+    codec_ctx->height = height;
+    codec_ctx->pix_fmt = AV_PIX_FMT_YUVJ422P;
+    codec_ctx->time_base = AVRational{1, 30};
+    codec_ctx->flags |= AV_CODEC_FLAG_QSCALE;
+    codec_ctx->global_quality = FF_QP2LAMBDA * 4;
+    if (fmt_ctx->oformat->flags & AVFMT_GLOBALHEADER) codec_ctx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+    AVStream* stream = avformat_new_stream(fmt_ctx, nullptr);
+    AVFrame* frame = av_frame_alloc();
+    AVPacket* packet = av_packet_alloc();
+    bool ok = stream && frame && packet && avcodec_open2(codec_ctx, codec, nullptr) >= 0 &&
+              avcodec_parameters_from_context(stream->codecpar, codec_ctx) >= 0 &&
+              avio_open(&fmt_ctx->pb, path.c_str(), AVIO_FLAG_WRITE) >= 0;
+    if (ok) {
+        stream->time_base = codec_ctx->time_base;
+        frame->format = codec_ctx->pix_fmt;
+        frame->width = width;
+        frame->height = height;
+        ok = av_frame_get_buffer(frame, 0) >= 0 && avformat_write_header(fmt_ctx, nullptr) >= 0;
+    }
+
+    auto drain = [&]() {
+        while (avcodec_receive_packet(codec_ctx, packet) >= 0) {
+            av_packet_rescale_ts(packet, codec_ctx->time_base, stream->time_base);
+            packet->stream_index = stream->index;
+            av_interleaved_write_frame(fmt_ctx, packet);
+        }
+    };
+    for (int i = 0; ok && i < num_frames; ++i) {
+        ok = av_frame_make_writable(frame) >= 0;
+        for (int y = 0; ok && y < height; ++y) {
+            uint8_t* luma = frame->data[0] + static_cast<ptrdiff_t>(y) * frame->linesize[0];
+            for (int x = 0; x < width; ++x) luma[x] = static_cast<uint8_t>(x + y + i * 4);
+            uint8_t* cb = frame->data[1] + static_cast<ptrdiff_t>(y) * frame->linesize[1];
+            uint8_t* cr = frame->data[2] + static_cast<ptrdiff_t>(y) * frame->linesize[2];
+            for (int x = 0; x < width / 2; ++x) {
+                cb[x] = static_cast<uint8_t>(128 + (x - i) % 64);
+                cr[x] = static_cast<uint8_t>(128 + (y + i) % 64);
+            }
+        }
+        frame->pts = i;
+        ok = ok && avcodec_send_frame(codec_ctx, frame) >= 0;
+        drain();
+    }
+    if (ok) {
+        avcodec_send_frame(codec_ctx, nullptr);
+        drain();
+        ok = av_write_trailer(fmt_ctx) >= 0;
+    }
+
+    if (fmt_ctx->pb) avio_closep(&fmt_ctx->pb);
+    av_packet_free(&packet);
+    av_frame_free(&frame);
+    avcodec_free_context(&codec_ctx);
+    avformat_free_context(fmt_ctx);
+    return ok;
+}
+
+bool run_one(const std::string& file, const DecodeOptions& decode_options, BenchResult& result) {
+    WebcamManager source(0, 0, 0, file, decode_options);
+    if (!source.initialize()) return false;
+    result.width = source.get_width();
+    result.height = source.get_height();
+
+    cv::Mat frame;
+    for (int i = 0; i < absl::GetFlag(FLAGS_warmup_frames) && source.grab();) {
+        if (source.retrieve(frame)) ++i;
+    }
+
+    const int max_frames = absl::GetFlag(FLAGS_frames);
+    const auto start = std::chrono::steady_clock::now();
+    while (result.frames < max_frames && source.grab()) {
+        if (source.retrieve(frame)) ++result.frames;
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result.frames > 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+    std::vector<std::string> files(args.begin() + 1, args.end());
+    for (const std::string& size : absl::GetFlag(FLAGS_generate)) {
+        int width = 0, height = 0;
+        if (std::sscanf(size.c_str(), "%dx%d", &width, &height) != 2 || width <= 0 || height <= 0) {
+            std::cerr << "⚠️ 해상도 형식이 잘못되었습니다: " << size << std::endl;
+            continue;
+        }
+        const std::string path = absl::GetFlag(FLAGS_generate_dir) + "/decode_bench_" + size + ".mkv";
+        std::cout << "🎞️ 클립 생성: " << path << std::endl;
+        if (!write_test_clip(path, width, height, absl::GetFlag(FLAGS_warmup_frames) + absl::GetFlag(FLAGS_frames))) {
+            std::cerr << "⚠️ 클립 생성 실패: " << path << std::endl;
+            continue;
+        }
+        files.push_back(path);
+    }
+    if (files.empty()) {
+        std::cerr << "사용법: decode_bench [--decode_threads=1,0] [--convert_threads=1,2,4] "
+                     "[--generate=1280x720,1920x1080,3840x2160] <녹화 파일>..." << std::endl;
+        return -1;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (const std::string& file : files) {
+        for (const std::string& decode_threads : absl::GetFlag(FLAGS_decode_threads)) {
+            for (const std::string& convert_threads : absl::GetFlag(FLAGS_convert_threads)) {
+                DecodeOptions decode_options;
+                decode_options.decode_threads = std::stoi(decode_threads);
+                decode_options.frame_threading = absl::GetFlag(FLAGS_frame_threading) && decode_options.decode_threads != 1;
+                decode_options.convert_threads = std::stoi(convert_threads);
+
+                BenchResult result;
+                if (!run_one(file, decode_options, result)) {
+                    std::cerr << "⚠️ 측정 실패: " << file << std::endl;
+                    continue;
+                }
+                std::cout << "📊 " << file << " " << result.width << "x" << result.height
+                          << " | 디코딩 " << decode_threads << (decode_options.frame_threading ? " (frame)" : "")
+                          << ", 변환 " << convert_threads
+                          << " | " << result.frames / result.seconds << " fps, "
+                          << result.seconds * 1000.0 / result.frames << " ms/프레임" << std::endl;
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+
+// 손가락 마스크: bit i 가 i 번 손가락이 펴졌는지입니다.
+// (bit 0: 엄지, 1: 검지, 2: 중지, 3: 약지, 4: 소지)
+enum FingerBit : uint8_t {
+    FINGER_THUMB  = 1 << 0,
+    FINGER_INDEX  = 1 << 1,
+    FINGER_MIDDLE = 1 << 2,
+    FINGER_RING   = 1 << 3,
+    FINGER_PINKY  = 1 << 4,
+};
+
+// 손가락 끝 랜드마크 인덱스 (엄지, 검지, 중지, 약지, 소지)
+constexpr int kFingertipIndices[5] = {4, 8, 12, 16, 20};
+
+// 손가락 펴짐 판정 규칙. GestureController 와 배치 분류(gesture_batch.cpp)의 스칼라 경로가 이 함수 하나를 씁니다.
+// x(i), y(i) 는 i 번 랜드마크의 정규화 좌표를 돌려주는 호출 가능 객체입니다.
+template <typename GetX, typename GetY>
+inline uint8_t raised_finger_mask(bool is_right, GetX x, GetY y) {
+    uint8_t mask = 0;
+
+    // 엄지: 오른손은 끝(4)이 첫 번째 마디(3)보다 x 가 크면, 왼손은 작으면 편 것으로 간주
+    const float thumb_tip = x(kFingertipIndices[0]);
+    const float thumb_ip = x(kFingertipIndices[0] - 1);
+    if (is_right ? (thumb_tip > thumb_ip) : (thumb_tip < thumb_ip)) mask |= FINGER_THUMB;
+
+    // 나머지 손가락: 끝의 y 가 두 마디 아래(PIP)보다 작으면(화면 위쪽) 편 것으로 간주
+    for (int i = 1; i < 5; ++i) {
+        if (y(kFingertipIndices[i]) < y(kFingertipIndices[i] - 2)) mask |= 1 << i;
+    }
+    return mask;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <opencv2/opencv.hpp>
+
+// 파이프라인에 RGB 프레임을 공급하는 쪽의 공통 인터페이스.
+// WebcamManager (v4l2 장치 / 녹화 파일) 와 SyntheticFrameSource (soak 테스트용) 가 구현합니다.
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    virtual bool initialize() = 0;
+
+    // 다음 프레임을 받아두기만 합니다. (장치라면 프레임이 올 때까지 블록)
+    virtual bool grab() = 0;
+    // 받아둔 프레임을 RGB 로 변환해 frame 에 씁니다.
+    virtual bool retrieve(cv::Mat& frame) = 0;
+    // 받아둔 프레임을 변환 없이 버립니다.
+    virtual bool discard() = 0;
+
+    // 받아둔 프레임의 roi 영역만 RGB 로 변환해 frame 에 씁니다.
+    // 색차 서브샘플링 정렬 등으로 영역을 조정하면 실제로 쓴 영역을 roi 에 돌려줍니다.
+    // 기본 구현은 전체를 변환한 뒤 잘라냅니다.
+    virtual bool retrieve_region(cv::Rect& roi, cv::Mat& frame) {
+        if (!retrieve(region_scratch_)) return false;
+        roi &= cv::Rect(0, 0, region_scratch_.cols, region_scratch_.rows);
+        region_scratch_(roi).copyTo(frame);
+        return true;
+    }
+
+    // 녹화 파일처럼 끝이 있는 소스가 끝났는지
+    virtual bool at_end() const { return false; }
+    // 실시간 소스(카메라, 합성 소스)인지. false 면 프레임을 버리지 않고 추론 자리가 날 때까지 기다립니다.
+    virtual bool is_live() const { return true; }
+
+    // 다음 프레임이 준비되면 읽기 가능해지는 fd (v4l2 장치 등). 이벤트 루프가 이 fd 를 기다렸다가 grab() 합니다.
+    // -1 이면 grab() 이 스스로 기다리거나(합성 소스) 기다릴 필요가 없는(녹화 파일) 소스입니다.
+    virtual int get_poll_fd() const { return -1; }
+
+    virtual int get_width() const = 0;
+    virtual int get_height() const = 0;
+
+    bool get_next_frame(cv::Mat& frame) { return grab() && retrieve(frame); }
+    bool skip_frame() { return grab() && discard(); }
+
+protected:
+    cv::Mat region_scratch_;  // retrieve_region() 기본 구현용
+};
@@ -0,0 +1,90 @@
+#include "gesture_batch.h"
+#include <algorithm>
+#include <thread>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+// 이 프레임 수보다 작으면 스레드 생성 비용이 더 큽니다.
+const std::size_t kMinFramesPerThread = 1 << 15;
+
+// 스칼라 경로: GestureController 와 같은 규칙 함수(finger_rule.h)를 씁니다.
+inline uint8_t classify_one(const LandmarkTraceSoA& t, std::size_t f) {
+    return raised_finger_mask(t.is_right[f] != 0, [&](int i) { return t.x[i][f]; }, [&](int i) { return t.y[i][f]; });
+}
+}  // namespace
+
+void LandmarkTraceSoA::resize(std::size_t frames) {
+    num_frames = frames;
+    for (int i = 0; i < NUM_LANDMARKS; ++i) {
+        x[i].resize(frames);
+        y[i].resize(frames);
+        z[i].resize(frames);
+    }
+    is_right.resize(frames);
+}
+
+void classify_raised_fingers_range(const LandmarkTraceSoA& t, std::size_t begin, std::size_t end, uint8_t* out_masks) {
+    std::size_t f = begin;
+
+#if defined(__SSE2__)
+    // ✨ 4 프레임씩 묶어서 비교합니다. 비교 결과(movemask)의 각 비트가 프레임 하나에 대응합니다.
+    const __m128i zero = _mm_setzero_si128();
+    for (; f + 4 <= end; f += 4) {
+        int bits[5];
+
+        // 엄지: 오른손은 tip > ip, 왼손은 tip < ip
+        int32_t hand_bytes;
+        std::copy(&t.is_right[f], &t.is_right[f] + 4, reinterpret_cast<uint8_t*>(&hand_bytes));
+        __m128i hand = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(hand_bytes), zero), zero);
+        __m128 is_left = _mm_castsi128_ps(_mm_cmpeq_epi32(hand, zero));
+
+        __m128 tip = _mm_loadu_ps(&t.x[kFingertipIndices[0]][f]);
+        __m128 ip = _mm_loadu_ps(&t.x[kFingertipIndices[0] - 1][f]);
+        __m128 right_raised = _mm_andnot_ps(is_left, _mm_cmpgt_ps(tip, ip));
+        __m128 left_raised = _mm_and_ps(is_left, _mm_cmplt_ps(tip, ip));
+        bits[0] = _mm_movemask_ps(_mm_or_ps(right_raised, left_raised));
+
+        // 나머지 손가락: tip.y < pip.y
+        for (int i = 1; i < 5; ++i) {
+            __m128 tip_y = _mm_loadu_ps(&t.y[kFingertipIndices[i]][f]);
+            __m128 pip_y = _mm_loadu_ps(&t.y[kFingertipIndices[i] - 2][f]);
+            bits[i] = _mm_movemask_ps(_mm_cmplt_ps(tip_y, pip_y));
+        }
+
+        for (int lane = 0; lane < 4; ++lane) {
+            uint8_t mask = 0;
+            for (int i = 0; i < 5; ++i) mask |= ((bits[i] >> lane) & 1) << i;
+            out_masks[f + lane] = mask;
+        }
+    }
+#endif
+
+    for (; f < end; ++f) out_masks[f] = classify_one(t, f);
+}
+
+void classify_raised_fingers_batch(const LandmarkTraceSoA& trace, uint8_t* out_masks, int num_threads) {
+    const std::size_t n = trace.num_frames;
+    if (num_threads <= 0) {
+        std::size_t by_size = n / kMinFramesPerThread;
+        std::size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        num_threads = static_cast<int>(std::max<std::size_t>(1, std::min(by_size, cores)));
+    }
+    if (num_threads == 1) {
+        classify_raised_fingers_range(trace, 0, n, out_masks);
+        return;
+    }
+
+    // 구간 경계를 4의 배수로 맞춰 각 스레드가 SIMD 경로를 끝까지 타도록 합니다.
+    std::size_t chunk = (n + num_threads - 1) / num_threads;
+    chunk = (chunk + 3) & ~static_cast<std::size_t>(3);
+
+    std::vector<std::thread> workers;
+    for (std::size_t begin = 0; begin < n; begin += chunk) {
+        std::size_t end = std::min(n, begin + chunk);
+        workers.emplace_back(classify_raised_fingers_range, std::cref(trace), begin, end, out_masks);
+    }
+    for (auto& worker : workers) worker.join();
+}
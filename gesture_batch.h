@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "finger_rule.h"
+
+// 녹화된 랜드마크 트레이스를 structure-of-arrays 형태로 보관합니다.
+// x[i][f] 는 f 번째 프레임의 i 번 랜드마크 x 좌표 (정규화 좌표) 입니다.
+struct LandmarkTraceSoA {
+    static const int NUM_LANDMARKS = 21;
+
+    std::size_t num_frames = 0;
+    std::vector<float> x[NUM_LANDMARKS];
+    std::vector<float> y[NUM_LANDMARKS];
+    std::vector<float> z[NUM_LANDMARKS];
+    std::vector<uint8_t> is_right;  // 1: "Right", 0: "Left"
+
+    void resize(std::size_t frames);
+};
+
+// 트레이스 전체의 손가락 마스크(FingerBit)를 한 번에 계산합니다. (out_masks 는 num_frames 크기)
+// num_threads <= 0 이면 프레임 수에 따라 코어 수만큼 자동으로 나눕니다.
+void classify_raised_fingers_batch(const LandmarkTraceSoA& trace, uint8_t* out_masks, int num_threads = 0);
+
+// 단일 스레드 버전. [begin, end) 프레임 구간만 처리합니다.
+void classify_raised_fingers_range(const LandmarkTraceSoA& trace, std::size_t begin, std::size_t end, uint8_t* out_masks);
@@ -0,0 +1,122 @@
+// gesture_batch_test.cpp
+// 배치 분류(SIMD + 스레드 분할)가 GestureController::finger_mask() 와 같은 마스크를 내는지 확인합니다.
+// 무작위 트레이스와 경계값(같은 값, ±0, ±inf, NaN, 왼손/오른손)을 두 경로에 모두 넣고 프레임마다 비교합니다.
+// 불일치가 있으면 처음 몇 개를 출력하고 0 이 아닌 값으로 끝납니다.
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gesture_batch.h"
+#include "gesture_controller.h"
+
+namespace {
+// 경계값: 비교식의 양쪽에 이 값들을 조합해서 넣습니다.
+const float kEdgeValues[] = {
+    0.0f, -0.0f, 0.5f, 1.0f, std::nextafter(0.5f, 1.0f),
+    std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::quiet_NaN(),
+};
+const int kNumEdgeValues = sizeof(kEdgeValues) / sizeof(kEdgeValues[0]);
+
+HandSample frame_sample(const LandmarkTraceSoA& trace, std::size_t f) {
+    HandSample sample;
+    sample.handedness = trace.is_right[f] ? Handedness::RIGHT : Handedness::LEFT;
+    for (int i = 0; i < HandSample::NUM_LANDMARKS; ++i) {
+        sample.landmarks[i][0] = trace.x[i][f];
+        sample.landmarks[i][1] = trace.y[i][f];
+        sample.landmarks[i][2] = trace.z[i][f];
+    }
+    return sample;
+}
+
+// 앞부분은 무작위, 뒷부분은 비교에 쓰는 랜드마크 쌍마다 경계값 조합을 넣은 트레이스.
+// 프레임 수는 4 의 배수가 아니게 해서 SIMD 뒤의 스칼라 꼬리도 지나가게 합니다.
+LandmarkTraceSoA make_trace(std::size_t random_frames, uint32_t seed) {
+    const std::size_t edge_frames = kNumEdgeValues * kNumEdgeValues * 2;
+    LandmarkTraceSoA trace;
+    trace.resize(random_frames + edge_frames + 3);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.0f, 1.0f);
+    // 값이 몇 개 안 되는 분포도 섞어서 tip == pip 인 경우가 자주 나오게 합니다.
+    std::uniform_int_distribution<int> coarse(0, 4);
+    for (std::size_t f = 0; f < trace.num_frames; ++f) {
+        const bool use_coarse = (f % 3) == 0;
+        for (int i = 0; i < LandmarkTraceSoA::NUM_LANDMARKS; ++i) {
+            trace.x[i][f] = use_coarse ? coarse(rng) * 0.25f : coord(rng);
+            trace.y[i][f] = use_coarse ? coarse(rng) * 0.25f : coord(rng);
+            trace.z[i][f] = coord(rng);
+        }
+        // 0/1 이 아닌 값도 오른손으로 취급되는지 봅니다.
+        trace.is_right[f] = static_cast<uint8_t>(rng() % 3);
+    }
+
+    std::size_t f = random_frames;
+    for (int hand = 0; hand < 2; ++hand) {
+        for (int a = 0; a < kNumEdgeValues; ++a) {
+            for (int b = 0; b < kNumEdgeValues; ++b, ++f) {
+                trace.is_right[f] = static_cast<uint8_t>(hand);
+                trace.x[kFingertipIndices[0]][f] = kEdgeValues[a];
+                trace.x[kFingertipIndices[0] - 1][f] = kEdgeValues[b];
+                for (int i = 1; i < 5; ++i) {
+                    // 손가락마다 조합을 돌려서 한 프레임 안에서도 결과가 섞이게 합니다.
+                    trace.y[kFingertipIndices[i]][f] = kEdgeValues[(a + i) % kNumEdgeValues];
+                    trace.y[kFingertipIndices[i] - 2][f] = kEdgeValues[(b + 2 * i) % kNumEdgeValues];
+                }
+            }
+        }
+    }
+    return trace;
+}
+
+int compare(const char* label, const LandmarkTraceSoA& trace, const std::vector<uint8_t>& masks,
+            std::size_t begin, std::size_t end) {
+    int mismatches = 0;
+    for (std::size_t f = begin; f < end; ++f) {
+        const uint8_t expected = GestureController::finger_mask(frame_sample(trace, f));
+        if (masks[f] == expected) continue;
+        if (++mismatches <= 5) {
+            std::printf("❌ %s: 프레임 %zu 배치 0x%02x, GestureController 0x%02x\n", label, f, masks[f], expected);
+        }
+    }
+    return mismatches;
+}
+}  // namespace
+
+int main() {
+    int failures = 0;
+    const std::size_t sizes[] = {0, 1, 3, 5, 4099, 200003};
+    for (std::size_t random_frames : sizes) {
+        const LandmarkTraceSoA trace = make_trace(random_frames, static_cast<uint32_t>(random_frames) + 1);
+        const std::size_t n = trace.num_frames;
+
+        // 단일 스레드 / 여러 스레드 / 자동
+        const int thread_counts[] = {1, 3, 8, 0};
+        for (int threads : thread_counts) {
+            std::vector<uint8_t> masks(n, 0xff);
+            classify_raised_fingers_batch(trace, masks.data(), threads);
+            char label[64];
+            std::snprintf(label, sizeof(label), "batch n=%zu threads=%d", n, threads);
+            failures += compare(label, trace, masks, 0, n);
+        }
+
+        // 4 의 배수가 아닌 위치에서 시작하는 구간 (정렬되지 않은 SIMD 로드)
+        if (n > 2) {
+            std::vector<uint8_t> masks(n, 0xff);
+            classify_raised_fingers_range(trace, 1, n - 1, masks.data());
+            char label[64];
+            std::snprintf(label, sizeof(label), "range n=%zu [1, %zu)", n, n - 1);
+            failures += compare(label, trace, masks, 1, n - 1);
+        }
+    }
+
+    if (failures) {
+        std::printf("⛔ 불일치 %d 건\n", failures);
+        return 1;
+    }
+    std::printf("✅ 배치 분류가 GestureController 와 모두 일치합니다.\n");
+    return 0;
+}
@@ -8,55 +8,37 @@ float GestureController::linear_interp(float x, float in_min, float in_max, floa
     return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
 
-std::vector<int> GestureController::get_raised_fingers(const LandmarkList& landmarks, const std::string& hand_label) {
-    std::vector<int> fingers(5, 0);
-    const int fingertip_indices[] = {4, 8, 12, 16, 20};
-    if (landmarks.size() < 21) return fingers;
-
-    // Thumb ( 엄지 )
-    if (hand_label == "Right") {
-        // 오른손: 엄지 끝(4)이 엄지 첫 번째 마디(3)보다 x값이 크면 편 것으로 간주
-        if (landmarks[fingertip_indices[0]].x > landmarks[fingertip_indices[0] - 1].x) {
-            fingers[0] = 1;
-        }
-    } else { // "Left"
-        // 왼손: 엄지 끝(4)이 엄지 첫 번째 마디(3)보다 x값이 작으면 편 것으로 간주
-        if (landmarks[fingertip_indices[0]].x < landmarks[fingertip_indices[0] - 1].x) {
-            fingers[0] = 1;
-        }
-    }
-
-    // Other fingers ( 나머지 손가락 )
-    for (int i = 1; i < 5; ++i) {
-        if (landmarks[fingertip_indices[i]].y < landmarks[fingertip_indices[i] - 2].y) {
-            fingers[i] = 1;
-        }
-    }
-    return fingers;
+uint8_t GestureController::finger_mask(const HandSample& sample) {
+    if (!sample.has_hand()) return 0;
+    return raised_finger_mask(sample.handedness == Handedness::RIGHT,
+                              [&](int i) { return sample.x(i); }, [&](int i) { return sample.y(i); });
 }
 
-void GestureController::handle_gestures(const LandmarkList& landmarks, const std::string& hand_label) {
-    if (landmarks.size() < 9) return;
+void GestureController::handle_gestures(const HandSample& sample) {
+    if (!sample.has_hand()) return;
 
-    std::vector<int> fingers = get_raised_fingers(landmarks, hand_label);
+    // 손가락 상태는 비트 마스크 하나로 다룹니다. (프레임마다 힙 할당 없음)
+    const uint8_t fingers = finger_mask(sample);
+    const uint8_t other_fingers = fingers & ~FINGER_THUMB;
+    last_finger_mask_ = fingers;
 
-    float index_finger_x = landmarks[8].x * CAM_WIDTH;
-    float index_finger_y = landmarks[8].y * CAM_HEIGHT;
+    float index_finger_x = sample.x(8) * CAM_WIDTH;
+    float index_finger_y = sample.y(8) * CAM_HEIGHT;
     float curr_x = prev_x_, curr_y = prev_y_;
 
-    bool is_drag_gesture = (fingers[0] == 0 && fingers[1] == 1 && fingers[2] == 1 && fingers[3] == 0 && fingers[4] == 0);
+    bool is_drag_gesture = (fingers == (FINGER_INDEX | FINGER_MIDDLE));
     
     // 엄지 손가락이 펴진 상태
-    if (fingers[0] == 1){
+    if (fingers & FINGER_THUMB){
         // 검지와 엄지를 핀 상태에서 검지를 접었을 때 : 좌클릭
-        if (fingers[1] == 0 && fingers[2] == 0 && fingers[3] == 0 && fingers[4] == 0) mouse_controller_.click(1);
+        if (other_fingers == 0) mouse_controller_.click(1);
         // 검지와 엄지, 소지지를 핀 상태: 오른쪽 클릭
-        else if (fingers[1] == 1 && fingers[2] == 0 && fingers[3] == 0 && fingers[4] == 1) mouse_controller_.click(3);
+        else if (other_fingers == (FINGER_INDEX | FINGER_PINKY)) mouse_controller_.click(3);
     }
     // 엄지 손가락이 접힌 상태
     else{
         // 검지 단독: 마우스 이동
-        if (fingers[1] == 1 && fingers[2] == 0 && fingers[3] == 0 && fingers[4] == 0) {
+        if (fingers == FINGER_INDEX) {
             float new_x = linear_interp(index_finger_x, BOUNDARY_REVISION, CAM_WIDTH - BOUNDARY_REVISION, 0, mouse_controller_.get_screen_width());
             float new_y = linear_interp(index_finger_y, BOUNDARY_REVISION, CAM_HEIGHT - BOUNDARY_REVISION, 0, mouse_controller_.get_screen_height());
             curr_x = prev_x_ + (new_x - prev_x_) * SMOOTH_ALPHA;
@@ -64,9 +46,9 @@ void GestureController::handle_gestures(const LandmarkList& landmarks, const std
             mouse_controller_.move(curr_x, curr_y);
         }
         // 주먹: 스크롤 다운
-        else if (fingers == std::vector<int>{0,0,0,0,0}) mouse_controller_.click(5);
+        else if (fingers == 0) mouse_controller_.click(5);
         // 새끼 단독: 스크롤 업
-        else if (fingers[4] == 1 && fingers[1] == 0 && fingers[2] == 0 && fingers[3] == 0) mouse_controller_.click(4);
+        else if (fingers == FINGER_PINKY) mouse_controller_.click(4);
     }
 
     if(is_drag_gesture){
@@ -1,24 +1,28 @@
 #pragma once
-#include <vector>
-#include <string>
-#include "mediapipe/tasks/cc/components/containers/landmark.h"
+#include <cstdint>
+#include "finger_rule.h"
+#include "hand_sample.h"
 #include "mouse_controller.h"
 
 class GestureController {
 public:
     GestureController(MouseController& mouse_controller);
 
-    void handle_gestures(const std::vector<mediapipe::tasks::components::containers::NormalizedLandmark>& landmarks, const std::string& hand_label);
+    void handle_gestures(const HandSample& sample);
 
-private:
-    using LandmarkList = std::vector<mediapipe::tasks::components::containers::NormalizedLandmark>;
+    // 손가락 상태 마스크 (FingerBit). 손이 없으면 0. 배치 분류(gesture_batch.h)와 같은 규칙입니다.
+    static uint8_t finger_mask(const HandSample& sample);
+
+    // 마지막 handle_gestures() 호출의 손가락 상태 (FingerBit)
+    uint8_t last_finger_mask() const { return last_finger_mask_; }
 
-    std::vector<int> get_raised_fingers(const LandmarkList& landmarks, const std::string& hand_label);
+private:
     float linear_interp(float x, float in_min, float in_max, float out_min, float out_max);
 
     MouseController& mouse_controller_;
     float prev_x_ = 0.0f, prev_y_ = 0.0f;
     bool mouse_hold_state_ = false;
+    uint8_t last_finger_mask_ = 0;
 
     // 상수 정의
     static const int CAM_WIDTH = 640;
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+
+// 파이프라인 내부에서 주고받는 손 하나의 결과.
+// MediaPipe 의 NormalizedLandmark (optional visibility/presence/name 포함) 벡터와 문자열 레이블 대신,
+// 고정 크기의 trivially copyable 구조체로 한 번만 변환해서 (hand_sample_conversion.h)
+// GestureController, 미리보기, 랜드마크 버스, 큐 등에 그대로 복사해 씁니다.
+
+enum class Handedness : uint8_t { NONE = 0, LEFT = 1, RIGHT = 2 };
+
+struct HandSample {
+    static const int NUM_LANDMARKS = 21;
+
+    float landmarks[NUM_LANDMARKS][3] = {};  // 정규화 좌표 x, y, z
+    Handedness handedness = Handedness::NONE;  // NONE 이면 손이 없는 프레임
+    int64_t timestamp_ms = 0;
+
+    bool has_hand() const { return handedness != Handedness::NONE; }
+    float x(int i) const { return landmarks[i][0]; }
+    float y(int i) const { return landmarks[i][1]; }
+    float z(int i) const { return landmarks[i][2]; }
+};
+
+static_assert(std::is_trivially_copyable<HandSample>::value, "HandSample 은 memcpy 로 복사할 수 있어야 합니다.");
+
+inline const char* handedness_label(Handedness handedness) {
+    switch (handedness) {
+        case Handedness::LEFT: return "Left";
+        case Handedness::RIGHT: return "Right";
+        default: return "";
+    }
+}
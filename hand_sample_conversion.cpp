@@ -0,0 +1,21 @@
+#include "hand_sample_conversion.h"
+
+HandSample to_hand_sample(const mediapipe::tasks::vision::hand_landmarker::HandLandmarkerResult& result, int64_t timestamp_ms) {
+    HandSample sample;
+    sample.timestamp_ms = timestamp_ms;
+
+    if (result.hand_landmarks.empty() || result.handedness.empty() || result.handedness[0].categories.empty()) {
+        return sample;
+    }
+    const auto& landmarks = result.hand_landmarks[0].landmarks;
+    if (landmarks.size() < HandSample::NUM_LANDMARKS) return sample;
+
+    for (int i = 0; i < HandSample::NUM_LANDMARKS; ++i) {
+        sample.landmarks[i][0] = landmarks[i].x;
+        sample.landmarks[i][1] = landmarks[i].y;
+        sample.landmarks[i][2] = landmarks[i].z;
+    }
+    const auto& category_name = result.handedness[0].categories[0].category_name;
+    sample.handedness = (category_name && *category_name == "Right") ? Handedness::RIGHT : Handedness::LEFT;
+    return sample;
+}
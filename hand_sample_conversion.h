@@ -0,0 +1,7 @@
+#pragma once
+#include "hand_sample.h"
+#include "mediapipe/tasks/cc/vision/hand_landmarker/hand_landmarker_result.h"
+
+// MediaPipe 결과의 첫 번째 손을 HandSample 로 변환합니다. (MediaPipe 경계에서 한 번만 호출)
+// 손이 없거나 랜드마크가 21 개가 아니면 handedness == NONE 인 샘플이 됩니다.
+HandSample to_hand_sample(const mediapipe::tasks::vision::hand_landmarker::HandLandmarkerResult& result, int64_t timestamp_ms);
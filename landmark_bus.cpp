@@ -0,0 +1,163 @@
+#include "landmark_bus.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+size_t mapping_size(uint32_t capacity) {
+    return offsetof(LandmarkBusHeader, slots) + sizeof(LandmarkBusSlot) * capacity;
+}
+
+// name 이 지금 가리키는 세그먼트가 (dev, ino) 인지 확인합니다.
+bool names_segment(const std::string& name, dev_t dev, ino_t ino) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st{};
+    bool same = fstat(fd, &st) == 0 && st.st_dev == dev && st.st_ino == ino;
+    close(fd);
+    return same;
+}
+}  // namespace
+
+LandmarkBusPublisher::~LandmarkBusPublisher() {
+    if (header_) {
+        munmap(header_, mapped_size_);
+        // 그 사이 다른 게시자가 같은 이름으로 새 버스를 만들었으면 그쪽은 지우지 않습니다.
+        if (names_segment(name_, segment_dev_, segment_ino_)) shm_unlink(name_.c_str());
+    }
+}
+
+bool LandmarkBusPublisher::initialize(const std::string& name, uint32_t capacity) {
+    name_ = name;
+    mapped_size_ = mapping_size(capacity);
+
+    // 기존 세그먼트는 크기를 바꾸거나 다시 초기화하지 않고 이름만 지운 뒤 새로 만듭니다.
+    // (이미 붙어 있는 구독자는 예전 매핑을 그대로 보므로 SIGBUS 나 중간 초기화가 없고, replaced() 로 알고 다시 붙습니다)
+    shm_unlink(name_.c_str());
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "⛔ 공유 메모리 생성 실패! (" << name_ << ": " << std::strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || ftruncate(fd, mapped_size_) != 0) {
+        std::cerr << "⛔ 공유 메모리 크기 설정 실패!" << std::endl;
+        close(fd);
+        shm_unlink(name_.c_str());
+        return false;
+    }
+    segment_dev_ = st.st_dev;
+    segment_ino_ = st.st_ino;
+    void* addr = mmap(nullptr, mapped_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "⛔ 공유 메모리 매핑 실패!" << std::endl;
+        shm_unlink(name_.c_str());
+        return false;
+    }
+
+    // 새로 만든 세그먼트라 0 으로 차 있습니다. 매직은 마지막에 써서 구독자가 초기화 중인 헤더를 받아들이지 않게 합니다.
+    header_ = static_cast<LandmarkBusHeader*>(addr);
+    header_->version = LandmarkBusHeader::VERSION;
+    header_->capacity = capacity;
+    header_->record_size = sizeof(LandmarkBusRecord);
+    header_->write_index.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < capacity; ++i) {
+        header_->slots[i].sequence.store(0, std::memory_order_relaxed);
+    }
+    header_->magic.store(LandmarkBusHeader::MAGIC, std::memory_order_release);
+    return true;
+}
+
+void LandmarkBusPublisher::publish(const LandmarkBusRecord& record) {
+    if (!header_) return;
+
+    const uint64_t index = header_->write_index.load(std::memory_order_relaxed);
+    LandmarkBusSlot& slot = header_->slots[index % header_->capacity];
+
+    // seqlock: 홀수로 바꾸고 → 데이터 쓰기 → 짝수(index + 1) * 2 로 마무리
+    slot.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(static_cast<void*>(&slot.record), &record, sizeof(record));
+    slot.sequence.store((index + 1) * 2, std::memory_order_release);
+
+    header_->write_index.store(index + 1, std::memory_order_release);
+}
+
+LandmarkBusReader::~LandmarkBusReader() {
+    if (header_) {
+        munmap(const_cast<LandmarkBusHeader*>(header_), mapped_size_);
+    }
+}
+
+bool LandmarkBusReader::attach(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        std::cerr << "⛔ 랜드마크 버스에 연결할 수 없습니다! (" << name << ")" << std::endl;
+        return false;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < mapping_size(1)) {
+        std::cerr << "⛔ 랜드마크 버스가 아직 초기화되지 않았습니다!" << std::endl;
+        close(fd);
+        return false;
+    }
+    mapped_size_ = static_cast<size_t>(st.st_size);
+    name_ = name;
+    segment_dev_ = st.st_dev;
+    segment_ino_ = st.st_ino;
+    void* addr = mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "⛔ 공유 메모리 매핑 실패!" << std::endl;
+        return false;
+    }
+
+    header_ = static_cast<const LandmarkBusHeader*>(addr);
+    if (header_->magic.load(std::memory_order_acquire) != LandmarkBusHeader::MAGIC ||
+        header_->version != LandmarkBusHeader::VERSION ||
+        header_->record_size != sizeof(LandmarkBusRecord) ||
+        mapping_size(header_->capacity) > mapped_size_) {
+        std::cerr << "⛔ 랜드마크 버스 버전이 맞지 않습니다!" << std::endl;
+        munmap(addr, mapped_size_);
+        header_ = nullptr;
+        return false;
+    }
+
+    // 연결 시점 이후의 레코드부터 읽습니다.
+    next_index_ = write_index();
+    return true;
+}
+
+bool LandmarkBusReader::replaced() const {
+    return header_ && !names_segment(name_, segment_dev_, segment_ino_);
+}
+
+bool LandmarkBusReader::next(LandmarkBusRecord& out) {
+    const uint64_t head = write_index();
+    if (next_index_ >= head) return false;
+
+    // 링 한 바퀴 이상 뒤처졌으면 남아있는 가장 오래된 레코드로 건너뜁니다.
+    if (head - next_index_ > header_->capacity) {
+        lapped_ += head - next_index_ - header_->capacity;
+        next_index_ = head - header_->capacity;
+    }
+
+    while (next_index_ < write_index()) {
+        const uint64_t index = next_index_++;
+        if (read(index, [&out](const LandmarkBusRecord& record) {
+                std::memcpy(static_cast<void*>(&out), &record, sizeof(out));
+            })) {
+            return true;
+        }
+        ++lapped_;  // 읽는 도중 덮어써짐
+    }
+    return false;
+}
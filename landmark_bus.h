@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+#include "hand_sample.h"
+
+// 랜드마크 결과를 POSIX 공유 메모리의 링 버퍼로 다른 로컬 프로세스에 배포합니다.
+// 쓰는 쪽은 VirtualTouchApp 하나, 읽는 쪽은 여러 개 (오버레이, 로거 등)입니다.
+// 각 슬롯은 seqlock 으로 보호되므로 읽기 경로에는 락도 시스템 콜도 없습니다.
+
+struct LandmarkBusRecord {
+    HandSample sample;          // 타임스탬프, 손 방향(손이 없으면 NONE), 랜드마크 21 개
+    int64_t publish_ns = 0;     // CLOCK_MONOTONIC 기준 게시 시각 (프로세스 간 지연 측정용)
+    uint8_t finger_mask = 0;    // finger_rule.h 의 FingerBit 와 같은 비트 배치
+};
+
+struct LandmarkBusSlot {
+    // 짝수: 안정, 홀수: 쓰는 중. 값 / 2 는 마지막으로 쓴 레코드 인덱스 + 1
+    std::atomic<uint64_t> sequence;
+    LandmarkBusRecord record;
+};
+
+struct LandmarkBusHeader {
+    static const uint32_t MAGIC = 0x564c4d42;  // "VLMB"
+    static const uint32_t VERSION = 2;
+
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t record_size;
+    alignas(64) std::atomic<uint64_t> write_index;  // 다음에 쓸 레코드 인덱스
+    alignas(64) LandmarkBusSlot slots[1];           // 실제 크기는 capacity
+};
+
+// 게시자: VirtualTouchApp 이 결과마다 publish() 를 호출합니다.
+// initialize() 는 같은 이름의 기존 세그먼트를 건드리지 않고 이름만 떼어낸 뒤 새로 만듭니다.
+class LandmarkBusPublisher {
+public:
+    LandmarkBusPublisher() = default;
+    ~LandmarkBusPublisher();
+
+    bool initialize(const std::string& name, uint32_t capacity = 256);
+    void publish(const LandmarkBusRecord& record);
+
+private:
+    std::string name_;
+    LandmarkBusHeader* header_ = nullptr;
+    size_t mapped_size_ = 0;
+    dev_t segment_dev_ = 0;  // 만든 세그먼트 (소멸자에서 이름이 아직 이것을 가리킬 때만 지움)
+    ino_t segment_ino_ = 0;
+};
+
+// 구독자 (클라이언트 라이브러리). attach() 이후의 읽기는 공유 메모리만 봅니다.
+class LandmarkBusReader {
+public:
+    LandmarkBusReader() = default;
+    ~LandmarkBusReader();
+
+    bool attach(const std::string& name);
+
+    // 지금까지 게시된 레코드 수 (= 다음에 쓰일 인덱스)
+    uint64_t write_index() const { return header_->write_index.load(std::memory_order_acquire); }
+    uint32_t capacity() const { return header_->capacity; }
+
+    // index 번째 레코드를 공유 메모리에서 직접 읽어 fn(const LandmarkBusRecord&) 에 넘깁니다. (복사 없음)
+    // fn 이 읽는 동안 덮어써졌다면 false 를 반환하며, 이때 fn 이 읽은 값은 버려야 합니다.
+    template <typename Fn>
+    bool read(uint64_t index, Fn&& fn) const {
+        const LandmarkBusSlot& slot = header_->slots[index % header_->capacity];
+        const uint64_t expected = (index + 1) * 2;
+        if (slot.sequence.load(std::memory_order_acquire) != expected) return false;
+        fn(slot.record);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == expected;
+    }
+
+    // 다음 레코드를 out 으로 복사합니다. 새 레코드가 없으면 false.
+    // 게시 속도를 못 따라가 덮어써진 레코드는 건너뛰고 lapped() 에 더합니다.
+    bool next(LandmarkBusRecord& out);
+    uint64_t lapped() const { return lapped_; }
+
+    // 게시자가 다시 시작해서 이름이 새 세그먼트를 가리키면 true. 이때는 새 리더로 다시 attach() 합니다.
+    // (시스템 콜을 하므로 레코드마다가 아니라 새 레코드가 한동안 없을 때만 확인합니다)
+    bool replaced() const;
+
+private:
+    std::string name_;
+    dev_t segment_dev_ = 0;
+    ino_t segment_ino_ = 0;
+    const LandmarkBusHeader* header_ = nullptr;
+    size_t mapped_size_ = 0;
+    uint64_t next_index_ = 0;
+    uint64_t lapped_ = 0;
+};
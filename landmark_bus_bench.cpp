@@ -0,0 +1,123 @@
+// landmark_bus_bench.cpp
+// 랜드마크 버스의 처리량과 게시→수신 지연을 여러 구독자를 동시에 붙여 측정합니다.
+// 사용법: landmark_bus_bench [구독자 수=4] [측정 시간(초)=5] [게시 속도(Hz), 0=최대=0]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <time.h>
+#include <unistd.h>
+
+#include "landmark_bus.h"
+
+namespace {
+int64_t monotonic_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+struct ReaderStats {
+    uint64_t received = 0;
+    uint64_t lapped = 0;
+    uint64_t torn = 0;  // 레코드 내용이 섞여 보인 횟수 (0 이어야 정상)
+    std::vector<int64_t> latencies_ns;
+};
+
+double percentile_us(std::vector<int64_t>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t k = static_cast<size_t>(p * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k] / 1000.0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    const int num_readers = argc > 1 ? std::atoi(argv[1]) : 4;
+    const double seconds = argc > 2 ? std::atof(argv[2]) : 5.0;
+    const double publish_hz = argc > 3 ? std::atof(argv[3]) : 0.0;
+    const std::string name = "/virtual_touch_bus_bench_" + std::to_string(getpid());
+
+    LandmarkBusPublisher publisher;
+    if (!publisher.initialize(name)) return -1;
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> ready{0};
+    std::atomic<int> failed{0};  // attach 에 실패한 구독자 수 (준비 대기가 끝나지 않는 것을 막음)
+    std::vector<ReaderStats> stats(num_readers);
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < num_readers; ++r) {
+        readers.emplace_back([&, r] {
+            // 각 구독자는 다른 프로세스처럼 독립적으로 매핑합니다.
+            LandmarkBusReader reader;
+            if (!reader.attach(name)) {
+                failed.fetch_add(1);
+                return;
+            }
+            ReaderStats& s = stats[r];
+            s.latencies_ns.reserve(1 << 20);
+            ready.fetch_add(1);
+
+            LandmarkBusRecord record;
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (!reader.next(record)) continue;
+                int64_t now = monotonic_ns();
+                ++s.received;
+                if (s.latencies_ns.size() < s.latencies_ns.capacity()) s.latencies_ns.push_back(now - record.publish_ns);
+                // 게시자는 모든 좌표를 timestamp_ms 로 채우므로 하나라도 다르면 찢어진 읽기입니다.
+                if (record.sample.landmarks[20][2] != static_cast<float>(record.sample.timestamp_ms)) ++s.torn;
+            }
+            s.lapped = reader.lapped();
+        });
+    }
+    while (ready.load() + failed.load() < num_readers) std::this_thread::yield();
+    if (failed.load() > 0) {
+        std::cerr << "⛔ 구독자 " << failed.load() << " 개가 버스에 붙지 못했습니다." << std::endl;
+        stop = true;
+        for (auto& reader : readers) reader.join();
+        return 1;
+    }
+
+    const int64_t interval_ns = publish_hz > 0 ? static_cast<int64_t>(1e9 / publish_hz) : 0;
+    const int64_t start = monotonic_ns();
+    const int64_t end = start + static_cast<int64_t>(seconds * 1e9);
+    int64_t next_due = start;
+    uint64_t published = 0;
+
+    LandmarkBusRecord record;
+    record.sample.handedness = Handedness::RIGHT;
+    while (true) {
+        int64_t now = monotonic_ns();
+        if (now >= end) break;
+        if (interval_ns > 0 && now < next_due) continue;
+        next_due += interval_ns;
+
+        record.sample.timestamp_ms = static_cast<int64_t>(published);
+        for (auto& landmark : record.sample.landmarks) {
+            landmark[0] = landmark[1] = landmark[2] = static_cast<float>(published);
+        }
+        record.publish_ns = monotonic_ns();
+        publisher.publish(record);
+        ++published;
+    }
+    const double elapsed = (monotonic_ns() - start) / 1e9;
+
+    stop = true;
+    for (auto& reader : readers) reader.join();
+
+    std::cout << "게시: " << published << " 레코드, " << static_cast<int64_t>(published / elapsed) << " 레코드/초" << std::endl;
+    for (int r = 0; r < num_readers; ++r) {
+        ReaderStats& s = stats[r];
+        std::cout << "구독자 " << r << ": 수신 " << s.received << ", 놓침 " << s.lapped << ", 찢어진 읽기 " << s.torn
+                  << ", 지연 p50 " << percentile_us(s.latencies_ns, 0.50) << "us"
+                  << " p99 " << percentile_us(s.latencies_ns, 0.99) << "us"
+                  << " max " << percentile_us(s.latencies_ns, 1.0) << "us" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+// 지연 시간 히스토그램. 여러 스레드에서 record() 해도 락이 없고, 메모리를 더 할당하지 않습니다.
+// 버킷은 1us 부터 약 2^(kBuckets/4) us 까지 로그 간격(1/4 옥타브)입니다.
+class LatencyHistogram {
+public:
+    static const int kBuckets = 96;
+
+    struct Snapshot {
+        std::array<uint64_t, kBuckets> counts{};
+        uint64_t total = 0;
+
+        // p (0~1) 백분위의 근사값 (us, 버킷 상한)
+        double percentile_us(double p) const {
+            if (total == 0) return 0.0;
+            uint64_t target = static_cast<uint64_t>(std::ceil(p * total));
+            if (target == 0) target = 1;
+            uint64_t seen = 0;
+            for (int i = 0; i < kBuckets; ++i) {
+                seen += counts[i];
+                if (seen >= target) return bucket_upper_us(i);
+            }
+            return bucket_upper_us(kBuckets - 1);
+        }
+    };
+
+    void record(int64_t latency_ns) {
+        counts_[bucket_for(latency_ns)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 지금까지 쌓인 값을 가져오고 0 으로 되돌립니다.
+    Snapshot take() {
+        Snapshot snapshot;
+        for (int i = 0; i < kBuckets; ++i) {
+            snapshot.counts[i] = counts_[i].exchange(0, std::memory_order_relaxed);
+            snapshot.total += snapshot.counts[i];
+        }
+        return snapshot;
+    }
+
+    static double bucket_upper_us(int bucket) { return std::pow(2.0, (bucket + 1) / 4.0); }
+
+private:
+    static int bucket_for(int64_t latency_ns) {
+        double us = latency_ns / 1000.0;
+        if (us <= 1.0) return 0;
+        int bucket = static_cast<int>(std::floor(std::log2(us) * 4.0));
+        return bucket < kBuckets ? bucket : kBuckets - 1;
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+};
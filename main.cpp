@@ -1,9 +1,62 @@
 #include "virtual_touch_app.h"
+#include "model_path.h"
+#include <csignal>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <pthread.h>
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+
+ABSL_FLAG(std::string, source, "/dev/video0", "v4l2 장치 경로 또는 리플레이할 녹화 파일");
+ABSL_FLAG(int, decode_threads, 1, "디코딩 스레드 수 (0 = 자동)");
+ABSL_FLAG(bool, decode_frame_threading, false, "프레임 단위 디코딩 스레딩 (처리량 ↑, 지연 ↑)");
+ABSL_FLAG(int, convert_threads, 1, "RGB 변환을 나눌 가로 띠(스레드) 수");
+ABSL_FLAG(bool, use_gpu, true, "GPU delegate 사용 여부");
+ABSL_FLAG(std::string, model, kDefaultModelPath, "손 랜드마크 모델 (.task) 경로");
+ABSL_FLAG(bool, preview, true, "미리보기 창 표시 여부");
+ABSL_FLAG(double, preview_max_fps, 15.0, "미리보기 최대 FPS (캡처/추론 속도와 무관)");
+ABSL_FLAG(double, preview_scale, 1.0, "미리보기 배율 (예: 0.5 = 절반 해상도)");
+ABSL_FLAG(std::string, preview_backend, "highgui", "미리보기 방식: highgui (cv::imshow) 또는 xshm (MIT-SHM, 로컬 X 서버)");
+ABSL_FLAG(double, idle_timeout_sec, 5.0, "손이 이 시간(초) 동안 없으면 유휴 상태로 전환 (0 = 비활성화)");
+ABSL_FLAG(int, idle_inference_interval, 6, "유휴 상태에서 몇 프레임마다 한 번 추론할지");
+ABSL_FLAG(std::string, landmark_bus, "", "결과를 게시할 공유 메모리 이름 (예: /virtual_touch_landmarks, 비우면 끔)");
+ABSL_FLAG(int, max_in_flight, 1, "동시에 추론 중일 수 있는 최대 프레임 수");
+ABSL_FLAG(bool, roi_tracking, false, "직전 손 위치 주변만 변환하고 나머지는 검게 채워 추론 (이미지 크기는 전체 프레임 그대로)");
+ABSL_FLAG(double, roi_margin, 0.5, "ROI 여백 (손 경계 상자 긴 변 대비 한쪽 비율)");
+ABSL_FLAG(int, roi_full_frame_interval, 15, "ROI 추적 중 몇 프레임마다 한 번 전체 프레임을 쓸지");
 
 int main(int argc, char** argv) {
-    auto app = std::make_unique<VirtualTouchApp>();
+    absl::ParseCommandLine(argc, argv);
+
+    VirtualTouchOptions options;
+    options.source = absl::GetFlag(FLAGS_source);
+    options.decode_threads = absl::GetFlag(FLAGS_decode_threads);
+    options.decode_frame_threading = absl::GetFlag(FLAGS_decode_frame_threading);
+    options.convert_threads = absl::GetFlag(FLAGS_convert_threads);
+    options.use_gpu = absl::GetFlag(FLAGS_use_gpu);
+    options.model_path = absl::GetFlag(FLAGS_model);
+    options.show_preview = absl::GetFlag(FLAGS_preview);
+    options.preview_max_fps = absl::GetFlag(FLAGS_preview_max_fps);
+    options.preview_scale = absl::GetFlag(FLAGS_preview_scale);
+    options.preview_backend = absl::GetFlag(FLAGS_preview_backend);
+    options.idle_timeout_sec = absl::GetFlag(FLAGS_idle_timeout_sec);
+    options.idle_inference_interval = absl::GetFlag(FLAGS_idle_inference_interval);
+    options.landmark_bus_name = absl::GetFlag(FLAGS_landmark_bus);
+    options.max_in_flight = absl::GetFlag(FLAGS_max_in_flight);
+    options.roi_tracking = absl::GetFlag(FLAGS_roi_tracking);
+    options.roi_margin = absl::GetFlag(FLAGS_roi_margin);
+    options.roi_full_frame_interval = absl::GetFlag(FLAGS_roi_full_frame_interval);
+
+    // SIGINT/SIGTERM 은 run() 의 signalfd 로 받아 정상 종료합니다. (공유 메모리 정리 등)
+    // MediaPipe/미리보기 스레드가 만들어지기 전에 막아야 모든 스레드에 상속됩니다.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    auto app = std::make_unique<VirtualTouchApp>(options);
 
     if (!app->setup()) {
         std::cerr << "Application setup failed!" << std::endl;
@@ -13,4 +66,4 @@ int main(int argc, char** argv) {
     app->run();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// 기본 손 랜드마크 모델 경로 (bazel 실행 위치 기준). 옵션/플래그 기본값은 모두 이것을 씁니다.
+inline constexpr char kDefaultModelPath[] = "mediapipe/examples/desktop/my_virtual_touch/hand_landmarker.task";
@@ -59,4 +59,14 @@ int MouseController::get_screen_width() const {
 
 int MouseController::get_screen_height() const {
     return screen_height_;
-}
\ No newline at end of file
+}
+
+void MouseController::process_events() {
+    if (!display_) return;
+    // 이벤트를 구독하지 않으므로 들어오는 건 비동기 오류나 서버 쪽 알림뿐입니다. 읽어서 버립니다.
+    // (연결이 끊어지면 Xlib 의 IO 오류 처리기가 호출됩니다)
+    while (XPending(display_) > 0) {
+        XEvent event;
+        XNextEvent(display_, &event);
+    }
+}
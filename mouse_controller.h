@@ -17,6 +17,11 @@ public:
     int get_screen_width() const;
     int get_screen_height() const;
 
+    // X 서버 연결의 소켓 fd (연결 전이면 -1). 이벤트 루프가 읽기 가능해지면 process_events() 를 부릅니다.
+    int connection_fd() const { return display_ ? ConnectionNumber(display_) : -1; }
+    // 쌓인 이벤트/오류를 읽어서 버립니다.
+    void process_events();
+
 private:
     Display* display_ = nullptr;
     Window root_window_;
@@ -0,0 +1,139 @@
+// preview_bench.cpp
+// 미리보기 방식(imshow / XShm)별로 프레임 하나를 화면에 올리는 데 드는 CPU 시간(렌더 스레드 + X 서버)을 비교합니다.
+// 카메라/추론 없이 미리 만든 프레임을 정해진 속도로 넘깁니다. X 서버가 없으면 Xvfb 로 돌립니다:
+//   xvfb-run -s "-screen 0 1920x1080x24" preview_bench --width=1280 --height=720
+// XShmPutImage 는 픽셀 복사를 서버 쪽으로 옮기므로, 클라이언트 CPU 만 보면 XShm 이 유리하게 나옵니다.
+// 그래서 같은 구간의 X 서버 프로세스 CPU 시간도 읽어서 프레임당 합계로 비교합니다.
+
+#include <chrono>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "preview_renderer.h"
+
+ABSL_FLAG(std::vector<std::string>, backends, std::vector<std::string>({"highgui", "xshm"}), "비교할 미리보기 방식");
+ABSL_FLAG(int, width, 1280, "프레임 너비");
+ABSL_FLAG(int, height, 720, "프레임 높이");
+ABSL_FLAG(double, scale, 1.0, "미리보기 배율");
+ABSL_FLAG(double, fps, 30.0, "미리보기 최대 FPS");
+ABSL_FLAG(double, duration_sec, 10.0, "방식마다 측정할 시간 (초)");
+ABSL_FLAG(int, server_pid, 0, "CPU 시간을 함께 잴 X 서버 pid (0 = Xvfb/Xorg 프로세스를 찾아서 사용)");
+
+namespace {
+// 매 프레임 내용이 바뀌도록 가로 위치만 다른 그라디언트 몇 장을 미리 만들어 둡니다.
+std::vector<std::shared_ptr<const mediapipe::ImageFrame>> make_frames(int width, int height, int count) {
+    std::vector<std::shared_ptr<const mediapipe::ImageFrame>> frames;
+    for (int i = 0; i < count; ++i) {
+        auto frame = std::make_shared<mediapipe::ImageFrame>(mediapipe::ImageFormat::SRGB, width, height);
+        for (int y = 0; y < height; ++y) {
+            uint8_t* row = frame->MutablePixelData() + static_cast<size_t>(y) * frame->WidthStep();
+            for (int x = 0; x < width; ++x) {
+                row[3 * x + 0] = static_cast<uint8_t>((x + i * width / count) * 255 / width);
+                row[3 * x + 1] = static_cast<uint8_t>(y * 255 / height);
+                row[3 * x + 2] = 128;
+            }
+        }
+        frames.push_back(std::move(frame));
+    }
+    return frames;
+}
+
+// /proc 에서 이름이 Xvfb 또는 Xorg 인 프로세스를 찾습니다. 없으면 0.
+int find_x_server_pid() {
+    DIR* proc = opendir("/proc");
+    if (!proc) return 0;
+    int found = 0;
+    while (dirent* entry = readdir(proc)) {
+        const int pid = std::atoi(entry->d_name);
+        if (pid <= 0) continue;
+        std::ifstream comm("/proc/" + std::to_string(pid) + "/comm");
+        std::string name;
+        if (std::getline(comm, name) && (name == "Xvfb" || name == "Xorg")) {
+            found = pid;
+            break;
+        }
+    }
+    closedir(proc);
+    return found;
+}
+
+// 프로세스가 지금까지 쓴 CPU 시간 (utime + stime, ns). 읽을 수 없으면 -1.
+int64_t process_cpu_ns(int pid) {
+    std::ifstream stat_file("/proc/" + std::to_string(pid) + "/stat");
+    std::string line;
+    if (pid <= 0 || !std::getline(stat_file, line)) return -1;
+    // comm 에 공백이 있을 수 있으므로 마지막 ')' 뒤부터 셉니다. (state 가 3 번째, utime/stime 이 14/15 번째 필드)
+    std::istringstream fields(line.substr(line.rfind(')') + 2));
+    std::string field;
+    int64_t utime = 0, stime = 0;
+    for (int i = 3; i <= 15 && fields >> field; ++i) {
+        if (i == 14) utime = std::stoll(field);
+        if (i == 15) stime = std::stoll(field);
+    }
+    return (utime + stime) * (1000000000 / sysconf(_SC_CLK_TCK));
+}
+
+HandSample make_sample() {
+    HandSample sample;
+    sample.handedness = Handedness::RIGHT;
+    for (int i = 0; i < HandSample::NUM_LANDMARKS; ++i) {
+        sample.landmarks[i][0] = 0.3f + 0.02f * i;
+        sample.landmarks[i][1] = 0.7f - 0.02f * i;
+    }
+    return sample;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+    const auto frames = make_frames(absl::GetFlag(FLAGS_width), absl::GetFlag(FLAGS_height), 8);
+    const HandSample sample = make_sample();
+    const int server_pid = absl::GetFlag(FLAGS_server_pid) > 0 ? absl::GetFlag(FLAGS_server_pid) : find_x_server_pid();
+    if (process_cpu_ns(server_pid) < 0) {
+        std::cerr << "⚠️ X 서버 프로세스를 찾지 못해 클라이언트 CPU 만 잽니다. (--server_pid 로 지정)" << std::endl;
+    }
+
+    for (const std::string& name : absl::GetFlag(FLAGS_backends)) {
+        PreviewBackend backend;
+        if (!parse_preview_backend(name, backend)) {
+            std::cerr << "⚠️ 알 수 없는 미리보기 방식: " << name << std::endl;
+            continue;
+        }
+
+        PreviewRenderer renderer(absl::GetFlag(FLAGS_fps), absl::GetFlag(FLAGS_scale), backend);
+        renderer.start();
+        const int64_t server_start_ns = process_cpu_ns(server_pid);
+
+        const auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(absl::GetFlag(FLAGS_duration_sec));
+        size_t index = 0;
+        while (std::chrono::steady_clock::now() < end) {
+            if (renderer.wants_frame()) renderer.submit(frames[index++ % frames.size()], sample, 30.0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        LatencyHistogram::Snapshot cost = renderer.take_render_cost_snapshot();
+        const int64_t server_end_ns = process_cpu_ns(server_pid);
+        renderer.stop();
+        std::cout << "🖼️ " << name << " " << absl::GetFlag(FLAGS_width) << "x" << absl::GetFlag(FLAGS_height)
+                  << " x" << absl::GetFlag(FLAGS_scale) << ": " << cost.total << " 프레임, 프레임당 클라이언트 CPU p50 "
+                  << cost.percentile_us(0.50) << "us, p99 " << cost.percentile_us(0.99) << "us";
+        if (server_start_ns >= 0 && server_end_ns >= 0 && cost.total > 0) {
+            // 서버 시간은 프로세스 누적값이라 분포 없이 프레임당 평균만 냅니다. (틱 단위라 측정 시간이 길수록 정확)
+            const double server_us = (server_end_ns - server_start_ns) / 1e3 / cost.total;
+            std::cout << ", X 서버 CPU 평균 " << server_us << "us, 합계(p50 기준) " << cost.percentile_us(0.50) + server_us
+                      << "us";
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "preview_renderer.h"
+#include <iostream>
+#include <string>
+#include <time.h>
+#include "xshm_window.h"
+#include "mediapipe/framework/formats/image_frame_opencv.h"
+
+namespace {
+const char* kWindowName = "Virtual Touch C++";
+
+int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 이 스레드가 지금까지 쓴 CPU 시간. (HighGUI 는 waitKey 안에서 실제로 그리므로 벽시계 대신 이걸로 비교합니다)
+int64_t thread_cpu_ns() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+}  // namespace
+
+bool parse_preview_backend(const std::string& name, PreviewBackend& backend) {
+    if (name == "highgui") {
+        backend = PreviewBackend::HIGHGUI;
+    } else if (name == "xshm") {
+        backend = PreviewBackend::XSHM;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+PreviewRenderer::PreviewRenderer(double max_fps, double scale, PreviewBackend backend)
+    : frame_interval_(std::chrono::nanoseconds(static_cast<int64_t>(1e9 / (max_fps > 0 ? max_fps : 15.0)))),
+      scale_(scale > 0 ? scale : 1.0),
+      backend_(backend) {}
+
+PreviewRenderer::~PreviewRenderer() {
+    stop();
+}
+
+void PreviewRenderer::start() {
+    if (running_) return;
+    running_ = true;
+    thread_ = std::thread(&PreviewRenderer::render_loop, this);
+}
+
+void PreviewRenderer::stop() {
+    if (!running_) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) thread_.join();
+}
+
+bool PreviewRenderer::wants_frame() const {
+    return running_.load(std::memory_order_relaxed) &&
+           steady_now_ns() >= next_due_ns_.load(std::memory_order_relaxed);
+}
+
+void PreviewRenderer::submit(std::shared_ptr<const mediapipe::ImageFrame> frame, const HandSample& sample, double pipeline_fps) {
+    // 렌더 스레드가 락을 잡고 있으면 기다리지 않고 이 프레임은 건너뜁니다.
+    std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) return;
+
+    pending_frame_ = std::move(frame);
+    pending_sample_ = sample;
+    pending_fps_ = pipeline_fps;
+    has_pending_ = true;
+    next_due_ns_.store(steady_now_ns() + frame_interval_.count(), std::memory_order_relaxed);
+    lock.unlock();
+    cv_.notify_one();
+}
+
+void PreviewRenderer::render_loop() {
+    if (backend_ == PreviewBackend::HIGHGUI) cv::namedWindow(kWindowName, cv::WINDOW_AUTOSIZE);
+
+    std::shared_ptr<const mediapipe::ImageFrame> frame;
+    HandSample sample;
+    double fps = 0.0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // 창 이벤트를 처리하도록 너무 오래 잠들지 않습니다.
+            cv_.wait_for(lock, frame_interval_, [this] { return has_pending_ || !running_; });
+            if (!running_) break;
+            if (has_pending_) {
+                frame = std::move(pending_frame_);
+                sample = pending_sample_;
+                fps = pending_fps_;
+                has_pending_ = false;
+            }
+        }
+
+        const bool rendering = static_cast<bool>(frame);
+        const int64_t start_cpu_ns = thread_cpu_ns();
+        if (rendering) {
+            cv::Mat rgb = mediapipe::formats::MatView(frame.get());
+            if (backend_ != PreviewBackend::XSHM || !render_xshm(rgb, sample, fps)) render_highgui(rgb, sample, fps);
+            frame.reset();  // ImageFrame 은 가능한 빨리 돌려줍니다.
+        }
+
+        // HighGUI 창은 highgui 방식일 때만 있으므로 그때만 waitKey 로 이벤트를 돌립니다.
+        // (xshm 방식에서 첫 프레임 전에 부르면 창도 없이 HighGUI 를 초기화합니다)
+        if (xshm_window_) {
+            if (xshm_window_->process_events()) quit_requested_ = true;
+        } else if (backend_ == PreviewBackend::HIGHGUI && cv::waitKey(1) == 'q') {
+            quit_requested_ = true;
+        }
+        if (rendering) render_cost_.record(thread_cpu_ns() - start_cpu_ns);
+    }
+
+    xshm_window_.reset();
+    if (backend_ == PreviewBackend::HIGHGUI) cv::destroyWindow(kWindowName);
+}
+
+void PreviewRenderer::render_highgui(const cv::Mat& rgb, const HandSample& sample, double fps) {
+    cv::cvtColor(rgb, bgr_buffer_, cv::COLOR_RGB2BGR);
+
+    cv::Mat& display = (scale_ != 1.0) ? scaled_buffer_ : bgr_buffer_;
+    if (scale_ != 1.0) cv::resize(bgr_buffer_, scaled_buffer_, cv::Size(), scale_, scale_, cv::INTER_AREA);
+
+    draw_overlay(display, sample, fps);
+    cv::imshow(kWindowName, display);
+}
+
+bool PreviewRenderer::render_xshm(const cv::Mat& rgb, const HandSample& sample, double fps) {
+    const cv::Size size(cvRound(rgb.cols * scale_), cvRound(rgb.rows * scale_));
+    if (xshm_window_ && (xshm_window_->width() != size.width || xshm_window_->height() != size.height)) {
+        xshm_window_.reset();  // 소스 해상도가 바뀌면 공유 이미지를 다시 만듭니다.
+    }
+    if (!xshm_window_) {
+        xshm_window_ = std::make_unique<XShmWindow>();
+        if (!xshm_window_->initialize(size.width, size.height, kWindowName)) {
+            std::cerr << "⚠️ XShm 미리보기를 쓸 수 없어 imshow 로 전환합니다." << std::endl;
+            xshm_window_.reset();
+            backend_ = PreviewBackend::HIGHGUI;
+            cv::namedWindow(kWindowName, cv::WINDOW_AUTOSIZE);
+            return false;
+        }
+    }
+
+    // 서버가 이전 프레임을 다 읽은 뒤에 공유 이미지에 바로 씁니다. (중간 BGR 버퍼 없음)
+    // 완료 이벤트가 제한 시간 안에 오지 않으면 그냥 덮어씁니다. (최악의 경우 한 프레임이 찢어져 보일 뿐)
+    if (!xshm_window_->wait_for_present()) {
+        std::cerr << "⚠️ 미리보기: XShm 완료 이벤트가 오지 않습니다." << std::endl;
+    }
+    cv::Mat canvas(size, CV_8UC4, xshm_window_->pixels(), xshm_window_->stride());
+    if (scale_ != 1.0) {
+        cv::resize(rgb, scaled_buffer_, size, 0, 0, cv::INTER_AREA);
+        cv::cvtColor(scaled_buffer_, canvas, cv::COLOR_RGB2BGRA);
+    } else {
+        cv::cvtColor(rgb, canvas, cv::COLOR_RGB2BGRA);
+    }
+
+    draw_overlay(canvas, sample, fps);
+    xshm_window_->present();
+    return true;
+}
+
+void PreviewRenderer::draw_overlay(cv::Mat& display, const HandSample& sample, double fps) {
+    if (sample.has_hand()) {
+        for (const auto& landmark : sample.landmarks) {
+            cv::circle(display, cv::Point(landmark[0] * display.cols, landmark[1] * display.rows), 5, cv::Scalar(255, 0, 255), cv::FILLED);
+        }
+    }
+    cv::putText(display, std::to_string(static_cast<int>(fps)), cv::Point(20, 50), cv::FONT_HERSHEY_PLAIN, 3, cv::Scalar(0, 255, 0), 3);
+}
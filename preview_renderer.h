@@ -0,0 +1,78 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <opencv2/opencv.hpp>
+#include <string>
+#include "hand_sample.h"
+#include "latency_histogram.h"
+#include "mediapipe/framework/formats/image_frame.h"
+
+class XShmWindow;
+
+// 미리보기를 화면에 올리는 방법
+enum class PreviewBackend {
+    HIGHGUI,  // cv::imshow (BGR 변환본을 HighGUI 가 다시 복사해 X 소켓으로 보냄)
+    XSHM,     // MIT-SHM 공유 이미지에 바로 변환/그리기 후 XShmPutImage (로컬 X 서버 전용)
+};
+
+// "highgui" / "xshm" → PreviewBackend. 모르는 이름이면 false.
+bool parse_preview_backend(const std::string& name, PreviewBackend& backend);
+
+// 미리보기 창을 별도 스레드에서 그립니다.
+// 파이프라인 루프는 submit() 으로 최신 프레임의 포인터만 넘기고, 렌더러가 바쁘면 그 프레임은 그냥 버립니다.
+// (캡처/추론 쪽으로 절대 back-pressure 가 걸리지 않도록)
+class PreviewRenderer {
+public:
+    PreviewRenderer(double max_fps, double scale, PreviewBackend backend = PreviewBackend::HIGHGUI);
+    ~PreviewRenderer();
+
+    void start();
+    void stop();
+
+    // 프레임 제한(max_fps)상 새 프레임을 받을 차례인지 확인합니다. 원자 변수 하나만 읽습니다.
+    bool wants_frame() const;
+
+    // 최신 프레임을 넘깁니다. 프레임은 이미 MediaPipe 에 넘겨진 불변 ImageFrame 이므로 복사하지 않습니다.
+    void submit(std::shared_ptr<const mediapipe::ImageFrame> frame, const HandSample& sample, double pipeline_fps);
+
+    // 미리보기 창에서 'q' 를 눌렀는지
+    bool quit_requested() const { return quit_requested_.load(std::memory_order_relaxed); }
+
+    // 그린 프레임마다 렌더 스레드가 쓴 CPU 시간 (변환 + 그리기 + 화면 올리기 + 창 이벤트 처리).
+    // X 서버 쪽 복사는 들어가지 않습니다. (방식끼리 비교할 때는 preview_bench 가 서버 CPU 도 함께 잽니다)
+    // 가져가면서 0 으로 초기화됩니다.
+    LatencyHistogram::Snapshot take_render_cost_snapshot() { return render_cost_.take(); }
+
+private:
+    void render_loop();
+    void render_highgui(const cv::Mat& rgb, const HandSample& sample, double fps);
+    bool render_xshm(const cv::Mat& rgb, const HandSample& sample, double fps);
+    void draw_overlay(cv::Mat& display, const HandSample& sample, double fps);
+
+    const std::chrono::nanoseconds frame_interval_;
+    const double scale_;
+    PreviewBackend backend_;  // XShm 을 쓸 수 없으면 렌더 스레드가 HIGHGUI 로 바꿉니다.
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> quit_requested_{false};
+    std::atomic<int64_t> next_due_ns_{0};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool has_pending_ = false;
+    std::shared_ptr<const mediapipe::ImageFrame> pending_frame_;
+    HandSample pending_sample_;
+    double pending_fps_ = 0.0;
+
+    // 렌더 스레드 전용 버퍼 (한 번만 할당)
+    cv::Mat bgr_buffer_;
+    cv::Mat scaled_buffer_;
+    std::unique_ptr<XShmWindow> xshm_window_;  // 첫 프레임 크기로 엽니다.
+
+    LatencyHistogram render_cost_;
+};
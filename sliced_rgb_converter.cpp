@@ -0,0 +1,155 @@
+#include "sliced_rgb_converter.h"
+#include <algorithm>
+#include <iostream>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixdesc.h>
+#include <libswscale/swscale.h>
+}
+
+SlicedRgbConverter::~SlicedRgbConverter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    start_cv_.notify_all();
+    for (auto& worker : workers_) worker.join();
+    for (auto& slice : slices_) sws_freeContext(slice.sws_ctx);
+    sws_freeContext(region_ctx_);
+}
+
+bool SlicedRgbConverter::initialize(int width, int height, int src_format, int num_slices) {
+    const AVPixelFormat format = static_cast<AVPixelFormat>(src_format);
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+    if (!desc) {
+        std::cerr << "⛔ 알 수 없는 픽셀 형식입니다! (" << src_format << ")" << std::endl;
+        return false;
+    }
+    width_ = width;
+    height_ = height;
+    src_format_ = src_format;
+
+    // 팔레트 형식은 data[1] 이 줄이 아니라 색표라서 띠나 영역으로 나눌 수 없습니다.
+    supports_region_ = !(desc->flags & (AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_BITSTREAM));
+    if (desc->flags & (AV_PIX_FMT_FLAG_PAL | AV_PIX_FMT_FLAG_HWACCEL)) num_slices = 1;
+
+    // 색차 평면은 서브샘플링되어 있으므로 띠/영역 시작 위치를 평면마다 줄여서 계산합니다.
+    if (!(desc->flags & AV_PIX_FMT_FLAG_RGB)) {
+        for (int c = 1; c < std::min<int>(desc->nb_components, 3); ++c) {
+            if (desc->comp[c].plane != desc->comp[0].plane) {
+                plane_shift_[desc->comp[c].plane] = desc->log2_chroma_h;
+                plane_x_shift_[desc->comp[c].plane] = desc->log2_chroma_w;
+            }
+        }
+    }
+    for (int c = 0; c < desc->nb_components; ++c) {
+        if (plane_x_step_[desc->comp[c].plane] == 0) plane_x_step_[desc->comp[c].plane] = desc->comp[c].step;
+    }
+    x_alignment_ = 1 << desc->log2_chroma_w;
+    y_alignment_ = 1 << desc->log2_chroma_h;
+
+    // 띠 경계는 색차 한 줄에 해당하는 줄 수(yuv420p 면 2 줄)의 배수로 맞춥니다.
+    const int align = 1 << desc->log2_chroma_h;
+    const int units = (height + align - 1) / align;
+    num_slices = std::max(1, std::min(num_slices, units));
+
+    slices_.resize(num_slices);
+    for (int i = 0; i < num_slices; ++i) {
+        Slice& slice = slices_[i];
+        slice.y = units * i / num_slices * align;
+        slice.height = std::min(height, units * (i + 1) / num_slices * align) - slice.y;
+        slice.sws_ctx = sws_getContext(width, slice.height, format, width, slice.height, AV_PIX_FMT_RGB24,
+                                       SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!slice.sws_ctx) {
+            std::cerr << "⛔ 색 변환 초기화 실패!" << std::endl;
+            return false;
+        }
+    }
+
+    for (int i = 1; i < num_slices; ++i) {
+        workers_.emplace_back(&SlicedRgbConverter::worker_loop, this, i);
+    }
+    return true;
+}
+
+void SlicedRgbConverter::convert(const AVFrame* frame, uint8_t* dst, int dst_stride) {
+    if (workers_.empty()) {
+        src_ = frame;
+        dst_ = dst;
+        dst_stride_ = dst_stride;
+        convert_slice(slices_[0]);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        src_ = frame;
+        dst_ = dst;
+        dst_stride_ = dst_stride;
+        pending_ = static_cast<int>(workers_.size());
+        ++generation_;
+    }
+    start_cv_.notify_all();
+
+    convert_slice(slices_[0]);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this] { return pending_ == 0; });
+}
+
+bool SlicedRgbConverter::convert_region(const AVFrame* frame, int x, int y, int width, int height, uint8_t* dst, int dst_stride) {
+    if (!supports_region_) return false;
+    // sws_getCachedContext 는 yuvj* 형식(MJPEG 웹캠)을 내부에서 yuv* + 색 범위로 바꿔 저장하므로
+    // 매번 다른 형식으로 보고 컨텍스트를 새로 만듭니다. 영역 크기로 직접 캐시합니다.
+    if (!region_ctx_ || width != region_width_ || height != region_height_) {
+        sws_freeContext(region_ctx_);
+        region_ctx_ = sws_getContext(width, height, static_cast<AVPixelFormat>(src_format_), width, height,
+                                     AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr, nullptr);
+        region_width_ = width;
+        region_height_ = height;
+        if (!region_ctx_) return false;
+    }
+
+    const uint8_t* src[4];
+    int src_stride[4];
+    for (int p = 0; p < 4; ++p) {
+        src_stride[p] = frame->linesize[p];
+        src[p] = frame->data[p] ? frame->data[p] + static_cast<ptrdiff_t>(y >> plane_shift_[p]) * src_stride[p] +
+                                      static_cast<ptrdiff_t>(x >> plane_x_shift_[p]) * plane_x_step_[p]
+                                : nullptr;
+    }
+    uint8_t* dst_planes[4] = {dst, nullptr, nullptr, nullptr};
+    int dst_strides[4] = {dst_stride, 0, 0, 0};
+    sws_scale(region_ctx_, src, src_stride, 0, height, dst_planes, dst_strides);
+    return true;
+}
+
+void SlicedRgbConverter::convert_slice(const Slice& slice) {
+    const uint8_t* src[4];
+    int src_stride[4];
+    for (int p = 0; p < 4; ++p) {
+        src_stride[p] = src_->linesize[p];
+        src[p] = src_->data[p] ? src_->data[p] + static_cast<ptrdiff_t>(slice.y >> plane_shift_[p]) * src_stride[p] : nullptr;
+    }
+    uint8_t* dst[4] = {dst_ + static_cast<ptrdiff_t>(slice.y) * dst_stride_, nullptr, nullptr, nullptr};
+    int dst_stride[4] = {dst_stride_, 0, 0, 0};
+    sws_scale(slice.sws_ctx, src, src_stride, 0, slice.height, dst, dst_stride);
+}
+
+void SlicedRgbConverter::worker_loop(int slice_index) {
+    uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) return;
+            seen_generation = generation_;
+        }
+
+        convert_slice(slices_[slice_index]);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) done_cv_.notify_one();
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// FFmpeg 헤더 전방 선언
+struct AVFrame;
+struct SwsContext;
+
+// 디코더 출력 프레임을 RGB24 로 변환합니다.
+// 프레임을 가로 띠(slice)로 나누고 띠마다 별도의 SwsContext 를 만들어 작은 작업자 풀이 나눠 변환합니다.
+// 크기 변경 없는 색 변환이라 띠끼리 서로 참조하지 않으므로 한 번에 변환한 결과와 같습니다.
+class SlicedRgbConverter {
+public:
+    SlicedRgbConverter() = default;
+    ~SlicedRgbConverter();
+
+    SlicedRgbConverter(const SlicedRgbConverter&) = delete;
+    SlicedRgbConverter& operator=(const SlicedRgbConverter&) = delete;
+
+    // src_format 은 AVPixelFormat 값입니다. num_slices <= 1 이면 작업자 없이 호출한 스레드에서 변환합니다.
+    bool initialize(int width, int height, int src_format, int num_slices);
+
+    // frame 전체를 dst (RGB24, 한 줄 dst_stride 바이트) 에 씁니다. 모든 띠가 끝나야 반환합니다.
+    void convert(const AVFrame* frame, uint8_t* dst, int dst_stride);
+
+    // frame 의 (x, y, width, height) 영역만 dst 에 씁니다. (ROI 추적용, 작은 영역이라 호출한 스레드에서 변환)
+    // x, y 는 x_alignment()/y_alignment() 의 배수여야 합니다. 영역 단위 변환을 못 하는 형식이면 false.
+    bool convert_region(const AVFrame* frame, int x, int y, int width, int height, uint8_t* dst, int dst_stride);
+    bool supports_region() const { return supports_region_; }
+    int x_alignment() const { return x_alignment_; }
+    int y_alignment() const { return y_alignment_; }
+
+    int num_slices() const { return static_cast<int>(slices_.size()); }
+
+private:
+    struct Slice {
+        SwsContext* sws_ctx = nullptr;
+        int y = 0;
+        int height = 0;
+    };
+
+    void convert_slice(const Slice& slice);
+    void worker_loop(int slice_index);
+
+    int width_ = 0;
+    int height_ = 0;
+    int src_format_ = -1;
+    int plane_shift_[4] = {};    // 평면별 세로 서브샘플링 (log2, 예: yuv420p 의 U/V 평면은 1)
+    int plane_x_shift_[4] = {};  // 평면별 가로 서브샘플링 (log2)
+    int plane_x_step_[4] = {};   // 평면별 가로 한 칸의 바이트 수 (yuyv422 면 2, nv12 색차 평면은 2)
+    std::vector<Slice> slices_;
+
+    // ROI 변환용 컨텍스트 (영역 크기가 바뀔 때만 다시 만듭니다)
+    SwsContext* region_ctx_ = nullptr;
+    int region_width_ = 0;
+    int region_height_ = 0;
+    bool supports_region_ = false;
+    int x_alignment_ = 1;
+    int y_alignment_ = 1;
+
+    // 현재 작업 (convert() 가 반환하기 전까지만 유효)
+    const AVFrame* src_ = nullptr;
+    uint8_t* dst_ = nullptr;
+    int dst_stride_ = 0;
+
+    // 작업자 i 는 띠 i + 1 을 맡고, 띠 0 은 convert() 를 호출한 스레드가 직접 변환합니다.
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    uint64_t generation_ = 0;
+    int pending_ = 0;
+    bool stopping_ = false;
+};
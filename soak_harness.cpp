@@ -0,0 +1,175 @@
+// soak_harness.cpp
+// 카메라/GPU/X 서버 없이 전체 파이프라인(프레임 준비 → HandLandmarker → 제스처 처리)을 몇 시간 동안 돌리며
+// RSS, 힙 사용량, 지연 백분위가 시간이 지나면서 늘어나는지(누수/드리프트) 확인합니다.
+// 기준값은 워밍업이 끝난 뒤 첫 샘플이며, 임계값을 넘으면 종료 코드 1 로 끝납니다.
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "virtual_touch_app.h"
+#include "synthetic_frame_source.h"
+
+ABSL_FLAG(double, duration_sec, 4 * 3600.0, "전체 실행 시간 (초)");
+ABSL_FLAG(double, sample_interval_sec, 60.0, "샘플링 간격 (초)");
+ABSL_FLAG(double, warmup_sec, 120.0, "기준값을 잡기 전 워밍업 시간 (초)");
+ABSL_FLAG(double, fps, 120.0, "합성 프레임 속도 (0 = 제한 없음)");
+ABSL_FLAG(int, width, 640, "프레임 너비");
+ABSL_FLAG(int, height, 480, "프레임 높이");
+ABSL_FLAG(std::string, image, "", "프레임으로 쓸 이미지 (손이 찍힌 사진이면 제스처 경로까지 돕니다)");
+ABSL_FLAG(double, max_rss_growth_mb, 32.0, "기준 대비 허용 RSS 증가량 (MB)");
+ABSL_FLAG(double, max_heap_growth_mb, 16.0, "기준 대비 허용 힙 사용량 증가량 (MB)");
+ABSL_FLAG(double, max_p99_ratio, 1.5, "기준 대비 허용 p99 지연 배율");
+ABSL_FLAG(int, drift_samples, 3, "지연 임계값을 연속 몇 번 넘어야 실패로 볼지");
+ABSL_FLAG(bool, roi_tracking, false, "ROI 추적을 켜고 ROI/전체 프레임 전환 중 손 추적 연속성도 확인");
+ABSL_FLAG(double, max_hand_loss_ratio, 0.01, "ROI 추적 시 허용하는 ROI 패스 손 놓침 비율");
+
+namespace {
+struct Sample {
+    double elapsed_sec = 0.0;
+    double rss_mb = 0.0;
+    double heap_mb = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double fps = 0.0;
+    int64_t rejected = 0;
+    int64_t dropped = 0;
+};
+
+double rss_mb() {
+    long pages_total = 0, pages_resident = 0;
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) return 0.0;
+    if (std::fscanf(statm, "%ld %ld", &pages_total, &pages_resident) != 2) pages_resident = 0;
+    std::fclose(statm);
+    return pages_resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+// malloc 으로 잡혀 있는 바이트 수 (arena + mmap 블록)
+double heap_in_use_mb() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+#else
+    struct mallinfo info = mallinfo();
+#endif
+    return (static_cast<double>(info.uordblks) + static_cast<double>(info.hblkhd)) / (1024.0 * 1024.0);
+}
+
+void print_sample(const Sample& s) {
+    std::printf("%10.0f %10.1f %10.1f %10.0f %10.0f %8.1f %10lld %10lld\n",
+                s.elapsed_sec, s.rss_mb, s.heap_mb, s.p50_us, s.p99_us, s.fps,
+                static_cast<long long>(s.rejected), static_cast<long long>(s.dropped));
+    std::fflush(stdout);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    absl::ParseCommandLine(argc, argv);
+
+    VirtualTouchOptions options;
+    options.camera_width = absl::GetFlag(FLAGS_width);
+    options.camera_height = absl::GetFlag(FLAGS_height);
+    options.use_gpu = false;
+    options.inject_mouse = false;
+    options.show_preview = false;
+    options.idle_timeout_sec = 0;  // 유휴 상태로 빠지면 부하가 줄어드므로 끕니다.
+    options.roi_tracking = absl::GetFlag(FLAGS_roi_tracking);
+
+    VirtualTouchApp app(options);
+    app.set_frame_source(std::make_unique<SyntheticFrameSource>(
+        options.camera_width, options.camera_height, absl::GetFlag(FLAGS_fps), absl::GetFlag(FLAGS_image)));
+    if (!app.setup()) {
+        std::cerr << "⛔ 파이프라인 초기화 실패!" << std::endl;
+        return -1;
+    }
+
+    std::thread pipeline([&app] { app.run(); });
+
+    const auto interval = std::chrono::duration<double>(absl::GetFlag(FLAGS_sample_interval_sec));
+    const double duration = absl::GetFlag(FLAGS_duration_sec);
+    const double warmup = absl::GetFlag(FLAGS_warmup_sec);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::printf("%10s %10s %10s %10s %10s %8s %10s %10s\n",
+                "elapsed_s", "rss_mb", "heap_mb", "p50_us", "p99_us", "fps", "rejected", "dropped");
+
+    bool has_baseline = false;
+    Sample baseline;
+    int p99_violations = 0;
+    int64_t last_frames = app.frames_submitted();
+    std::string failure;
+    app.take_latency_snapshot();
+
+    while (failure.empty()) {
+        std::this_thread::sleep_for(interval);
+
+        Sample s;
+        s.elapsed_sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        s.rss_mb = rss_mb();
+        s.heap_mb = heap_in_use_mb();
+        LatencyHistogram::Snapshot latency = app.take_latency_snapshot();
+        s.p50_us = latency.percentile_us(0.50);
+        s.p99_us = latency.percentile_us(0.99);
+        int64_t frames = app.frames_submitted();
+        s.fps = (frames - last_frames) / interval.count();
+        last_frames = frames;
+        s.rejected = app.frames_rejected();
+        s.dropped = app.frames_dropped_in_graph();
+        print_sample(s);
+
+        if (latency.total == 0) {
+            failure = "구간 동안 결과가 하나도 나오지 않았습니다 (파이프라인 멈춤)";
+        } else if (s.elapsed_sec >= warmup) {
+            if (!has_baseline) {
+                baseline = s;
+                has_baseline = true;
+            } else if (s.rss_mb - baseline.rss_mb > absl::GetFlag(FLAGS_max_rss_growth_mb)) {
+                failure = "RSS 증가 " + std::to_string(s.rss_mb - baseline.rss_mb) + " MB";
+            } else if (s.heap_mb - baseline.heap_mb > absl::GetFlag(FLAGS_max_heap_growth_mb)) {
+                failure = "힙 사용량 증가 " + std::to_string(s.heap_mb - baseline.heap_mb) + " MB";
+            } else if (s.p99_us > baseline.p99_us * absl::GetFlag(FLAGS_max_p99_ratio)) {
+                // 지연은 잡음이 많으므로 연속으로 넘을 때만 실패로 봅니다.
+                if (++p99_violations >= absl::GetFlag(FLAGS_drift_samples)) {
+                    failure = "p99 지연 " + std::to_string(s.p99_us) + "us (기준 " + std::to_string(baseline.p99_us) + "us)";
+                }
+            } else {
+                p99_violations = 0;
+            }
+        }
+
+        if (s.elapsed_sec >= duration) break;
+    }
+
+    app.stop();
+    pipeline.join();
+
+    // 손이 찍힌 이미지(--image)로 돌리면 ROI 패스와 전체 패스가 번갈아 나오는 동안 손을 놓치는지 봅니다.
+    if (options.roi_tracking) {
+        const VirtualTouchApp::HandLossStats full = app.hand_loss_stats(false);
+        const VirtualTouchApp::HandLossStats roi = app.hand_loss_stats(true);
+        auto ratio = [](const VirtualTouchApp::HandLossStats& stats) {
+            return stats.results ? static_cast<double>(stats.lost) / stats.results : 0.0;
+        };
+        std::printf("🤚 손 놓침 비율: 전체 프레임 %.4f (%lld/%lld), ROI %.4f (%lld/%lld)\n",
+                    ratio(full), static_cast<long long>(full.lost), static_cast<long long>(full.results),
+                    ratio(roi), static_cast<long long>(roi.lost), static_cast<long long>(roi.results));
+        if (failure.empty() && ratio(roi) > absl::GetFlag(FLAGS_max_hand_loss_ratio)) {
+            failure = "ROI 패스 손 놓침 비율 " + std::to_string(ratio(roi));
+        }
+    }
+
+    if (!failure.empty()) {
+        std::cerr << "❌ soak 실패: " << failure << std::endl;
+        return 1;
+    }
+    std::cout << "✅ soak 통과" << std::endl;
+    return 0;
+}
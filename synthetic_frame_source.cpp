@@ -0,0 +1,59 @@
+#include "synthetic_frame_source.h"
+#include <iostream>
+#include <thread>
+
+SyntheticFrameSource::SyntheticFrameSource(int width, int height, double fps, const std::string& image_path)
+    : width_(width), height_(height), fps_(fps), image_path_(image_path) {}
+
+bool SyntheticFrameSource::initialize() {
+    cv::Mat tile;
+    if (!image_path_.empty()) {
+        cv::Mat bgr = cv::imread(image_path_, cv::IMREAD_COLOR);
+        if (bgr.empty()) {
+            std::cerr << "⛔ 합성 프레임 이미지를 읽을 수 없습니다! (" << image_path_ << ")" << std::endl;
+            return false;
+        }
+        cv::cvtColor(bgr, tile, cv::COLOR_BGR2RGB);
+        cv::resize(tile, tile, cv::Size(width_, height_));
+    } else {
+        tile = cv::Mat(height_, width_, CV_8UC3);
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                tile.at<cv::Vec3b>(y, x) = cv::Vec3b(x * 255 / width_, y * 255 / height_, 128);
+            }
+        }
+        cv::circle(tile, cv::Point(width_ / 2, height_ / 2), height_ / 6, cv::Scalar(230, 190, 160), cv::FILLED);
+    }
+    // 좌우로 이어 붙여 두면 잘라낼 위치만 바꿔서 움직이는 영상을 만들 수 있습니다.
+    cv::hconcat(tile, tile, base_);
+    next_due_ = std::chrono::steady_clock::now();
+    return true;
+}
+
+bool SyntheticFrameSource::grab() {
+    // 실제 카메라처럼 다음 프레임 시각까지 블록합니다.
+    if (fps_ > 0) {
+        next_due_ += std::chrono::nanoseconds(static_cast<int64_t>(1e9 / fps_));
+        auto now = std::chrono::steady_clock::now();
+        if (next_due_ > now) {
+            std::this_thread::sleep_until(next_due_);
+        } else if (now - next_due_ > std::chrono::seconds(1)) {
+            next_due_ = now;  // 크게 밀렸으면 따라잡지 않고 다시 맞춥니다.
+        }
+    }
+    ++frame_index_;
+    return true;
+}
+
+bool SyntheticFrameSource::retrieve(cv::Mat& frame) {
+    int offset = static_cast<int>((frame_index_ * 4) % width_);
+    base_(cv::Rect(offset, 0, width_, height_)).copyTo(frame);
+    return true;
+}
+
+bool SyntheticFrameSource::retrieve_region(cv::Rect& roi, cv::Mat& frame) {
+    roi &= cv::Rect(0, 0, width_, height_);
+    int offset = static_cast<int>((frame_index_ * 4) % width_);
+    base_(cv::Rect(offset + roi.x, roi.y, roi.width, roi.height)).copyTo(frame);
+    return true;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <opencv2/opencv.hpp>
+#include "frame_source.h"
+
+// 카메라 없이 파이프라인을 돌리기 위한 합성 프레임 소스. (soak/stress 테스트용)
+// image_path 가 있으면 그 이미지(손이 찍힌 사진 등)를 조금씩 움직이며 반복하고,
+// 없으면 움직이는 패턴을 그립니다. fps 가 0 이면 속도 제한 없이 만듭니다.
+class SyntheticFrameSource : public FrameSource {
+public:
+    SyntheticFrameSource(int width, int height, double fps, const std::string& image_path = "");
+
+    bool initialize() override;
+    bool grab() override;
+    bool retrieve(cv::Mat& frame) override;
+    bool retrieve_region(cv::Rect& roi, cv::Mat& frame) override;
+    bool discard() override { return true; }
+
+    int get_width() const override { return width_; }
+    int get_height() const override { return height_; }
+
+private:
+    int width_;
+    int height_;
+    double fps_;
+    std::string image_path_;
+
+    cv::Mat base_;  // 폭이 2배인 원본. 프레임마다 다른 위치를 잘라 씁니다.
+    int64_t frame_index_ = 0;
+    std::chrono::steady_clock::time_point next_due_;
+};
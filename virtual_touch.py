@@ -1,79 +1,32 @@
-import cv2
-import mediapipe as mp
-import numpy as np
-import pyautogui
-import autopy
-import time
-#import speech_recognition as sr
-from gesture_recognizer import GestureRecognizer
+import sys
+import virtual_touch_cc
 
-def main():
-    # 기본 설정값
-    prev_x, prev_y = 0, 0  # 이전 마우스 위치
-    prev_time = 0  # FPS 계산용 이전 시간
-    mouse_hold_state = False    # 마우스 홀드 상태
-    
-    interval = 0.01  # 타이핑 시 키 입력 간격
-    timeout = 5  # 음성 인식 타임아웃
-    phrase_time_limit = 10  # 음성 인식 최대 시간
-    
-    """
-    # 음성 인식기 초기화
-    r = sr.Recognizer()
-    m = sr.Microphone()
-
-    def speech_to_text():
-        # 음성을 텍스트로 변환하는 함수
-        with m as source:
-            r.adjust_for_ambient_noise(source)
-            try:
-                audio = r.listen(source, timeout=timeout, phrase_time_limit=phrase_time_limit)
-                return r.recognize_google(audio)
-            except (sr.UnknownValueError, sr.RequestError, sr.WaitTimeoutError):
-                return ''
-    """
-    # 화면 크기 가져오기
-    scr_w, scr_h = autopy.screen.size()  
+# 예전 순수 Python 구현(cv2.VideoCapture + GestureRecognizer + autopy/pyautogui)은
+# C++ 파이프라인 바인딩으로 대체되었습니다. 프레임 루프, 변환, 마우스 입력은 모두 C++ 에서 동작합니다.
+# (gesture_recognizer.py 는 기존 스크립트와 benchmark_bindings.py 비교용으로 남겨둡니다)
 
-    # 카메라 설정
-    # 해상도 고정 크기로 받아오기 -> 카메라 별로 지원 해상도가 다름
-    cap = cv2.VideoCapture(0)
-    cap.set(cv2.CAP_PROP_FRAME_WIDTH, 640)
-    cap.set(cv2.CAP_PROP_FRAME_HEIGHT, 480)
-    cap.set(cv2.CAP_PROP_FPS, 30)
+def main():
+    options = virtual_touch_cc.Options()
+    options.camera_width = 640
+    options.camera_height = 480
+    options.camera_fps = 30
+    if len(sys.argv) > 1:
+        # 녹화 파일 경로를 주면 리플레이합니다.
+        options.source = sys.argv[1]
 
-    # 프레임 크기 가져오기
-    ret, frame = cap.read()
-    if not ret:
+    pipeline = virtual_touch_cc.Pipeline(options)
+    if not pipeline.setup():
         print("카메라 초기화 실패")
         exit()
- 
-    # 제스처 인식기 초기화
-    detector = GestureRecognizer(scr_w, scr_h)            
-
-    while True:
-        _, img = cap.read()
-        img = detector.detect_hands(img)
-        lm_list = detector.get_landmarks(img)      
 
-        
-        if len(lm_list) != 0:
-            fingers = detector.is_fingers_raised()
-            prev_x, prev_y, mouse_hold_state = detector.mouse_event(fingers, prev_x, prev_y, mouse_hold_state)
-        
-        # FPS 표시
-        curr_time = time.time()
-        fps = 1 / (curr_time - prev_time)
-        prev_time = curr_time
-        cv2.putText(img, str(int(fps)), (20, 50), cv2.FONT_HERSHEY_PLAIN, 3, (0, 0, 0), 3)
-        cv2.imshow("virtual_touch", img)
-        
-        # 'q' 키를 누르면 종료
-        if cv2.waitKey(1) & 0xFF == ord('q'):
-            break
-    
-    cap.release()
-    cv2.destroyAllWindows()
+    # 'q' 키(미리보기 창) 또는 Ctrl+C로 종료
+    # (run() 은 루프를 기다리면서 주기적으로 시그널을 확인하므로 Ctrl+C 가 KeyboardInterrupt 로 올라옵니다)
+    try:
+        pipeline.run()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        pipeline.stop()
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
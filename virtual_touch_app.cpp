@@ -2,31 +2,202 @@
 
 #include "virtual_touch_app.h"
 #include "webcam_manager.h"
+#include "frame_source.h"
 #include "mouse_controller.h"
 #include "gesture_controller.h"
+#include "preview_renderer.h"
+#include "landmark_bus.h"
+#include "hand_sample_conversion.h"
 
 #include <iostream>
 #include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
 #include <functional>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
 #include <opencv2/opencv.hpp>
 #include "mediapipe/tasks/cc/core/base_options.h"
 
-VirtualTouchApp::VirtualTouchApp() = default;
+namespace {
+// steady_clock 은 리눅스에서 CLOCK_MONOTONIC 이므로 다른 프로세스와 비교할 수 있습니다.
+int64_t steady_now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 프로세스 전체의 CPU 사용 시간 (user + sys, 초)
+double process_cpu_seconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+           (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// 상주 메모리 중 익명(힙 등) / 파일 매핑 부분 (MB). 모델을 mmap 하면 모델 크기만큼이 파일 쪽으로 옮겨갑니다.
+void resident_memory_mb(double& anon_mb, double& file_mb) {
+    anon_mb = file_mb = 0.0;
+    FILE* status = std::fopen("/proc/self/status", "r");
+    if (!status) return;
+    char line[256];
+    long kb = 0;
+    while (std::fgets(line, sizeof(line), status)) {
+        if (std::sscanf(line, "RssAnon: %ld kB", &kb) == 1) anon_mb = kb / 1024.0;
+        if (std::sscanf(line, "RssFile: %ld kB", &kb) == 1) file_mb = kb / 1024.0;
+    }
+    std::fclose(status);
+}
+
+// epoll 이벤트의 출처 (epoll_event.data.u32)
+enum EventSource : uint32_t { kFrameEvent, kResultEvent, kXEvent, kSignalEvent };
+
+void watch_fd(int epoll_fd, int fd, EventSource source) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u32 = source;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        std::cerr << "⚠️ epoll 등록 실패! (fd " << fd << ", " << std::strerror(errno) << ")" << std::endl;
+    }
+}
+
+// ROI 한 변의 최소 길이와 크기 단위 (px). 크기를 단위로 맞춰 두면 영역 변환 컨텍스트를 프레임마다 다시 만들지 않습니다.
+const int kRoiMinSize = 128;
+const int kRoiSizeStep = 32;
+
+// 직전 샘플(좌우 반전된 정규화 좌표)의 경계 상자에 여백을 더한 정사각형 영역을 원본 프레임 좌표로 구합니다.
+// 영역이 프레임 대부분을 덮으면 잘라내도 이득이 없으므로 false.
+bool hand_region(const HandSample& sample, int frame_width, int frame_height, double margin, cv::Rect& roi) {
+    float min_x = 1.0f, max_x = 0.0f, min_y = 1.0f, max_y = 0.0f;
+    for (int i = 0; i < HandSample::NUM_LANDMARKS; ++i) {
+        min_x = std::min(min_x, sample.x(i));
+        max_x = std::max(max_x, sample.x(i));
+        min_y = std::min(min_y, sample.y(i));
+        max_y = std::max(max_y, sample.y(i));
+    }
+    // 추론에는 반전한 프레임을 넘기므로 원본 프레임의 x 는 1 - x 입니다.
+    const double center_x = (1.0 - (min_x + max_x) / 2) * frame_width;
+    const double center_y = (min_y + max_y) / 2 * frame_height;
+    const double box = std::max((max_x - min_x) * frame_width, (max_y - min_y) * frame_height);
+
+    int size = static_cast<int>(box * (1.0 + 2.0 * margin));
+    size = std::max(kRoiMinSize, (size + kRoiSizeStep - 1) / kRoiSizeStep * kRoiSizeStep);
+    if (size * size > frame_width * frame_height / 2 || size > frame_width || size > frame_height) return false;
+
+    const int x = std::clamp(static_cast<int>(center_x) - size / 2, 0, frame_width - size);
+    const int y = std::clamp(static_cast<int>(center_y) - size / 2, 0, frame_height - size);
+    roi = cv::Rect(x, y, size, size);
+    return true;
+}
+
+// keep 영역 밖을 검게 채웁니다. (ROI 패스에서 변환하지 않은 부분에 이전 프레임이나 쓰레기 값이 남지 않도록)
+void fill_outside(cv::Mat& image, const cv::Rect& keep) {
+    const cv::Scalar black = cv::Scalar::all(0);
+    image.rowRange(0, keep.y).setTo(black);
+    image.rowRange(keep.y + keep.height, image.rows).setTo(black);
+    image(cv::Rect(0, keep.y, keep.x, keep.height)).setTo(black);
+    image(cv::Rect(keep.x + keep.width, keep.y, image.cols - (keep.x + keep.width), keep.height)).setTo(black);
+}
+
+// 녹화 파일 리플레이에서 추론 자리를 기다리는 최대 시간 (보통은 결과 eventfd 가 먼저 깨움)
+const int kReplayCapacityWaitMs = 100;
+
+void notify_event_fd(int fd) {
+    if (fd < 0) return;
+    const uint64_t one = 1;
+    ssize_t written = write(fd, &one, sizeof(one));
+    (void)written;  // 카운터가 넘칠 정도로 쌓였다면 이미 깨울 일이 남아 있는 것입니다.
+}
+}  // namespace
+
+// ROI 패스에 쓰는 전체 프레임 크기 ImageFrame 을 재사용합니다. 손 영역 밖은 처음 만들 때 한 번만 검게 채우고,
+// 그래프와 결과 콜백이 모두 놓은 프레임을 다시 쓸 때는 직전에 쓴 손 영역만 지웁니다.
+// (매 ROI 패스마다 전체 크기를 할당하고 채우는 비용이 영역 변환보다 컸습니다)
+class VirtualTouchApp::RoiFramePool {
+public:
+    // 돌려주는 프레임은 keep 밖이 모두 검고, keep 안은 호출하는 쪽이 채웁니다.
+    std::shared_ptr<mediapipe::ImageFrame> acquire(int width, int height, const cv::Rect& keep) {
+        for (Entry& entry : entries_) {
+            if (entry.image.use_count() != 1 || entry.image->Width() != width || entry.image->Height() != height) continue;
+            // 다른 스레드가 참조를 놓기 전에 한 마지막 읽기보다 뒤에 쓰도록 합니다.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            cv::Mat pixels(height, width, CV_8UC3, entry.image->MutablePixelData(), entry.image->WidthStep());
+            pixels(entry.last_roi).setTo(cv::Scalar::all(0));
+            entry.last_roi = keep;
+            return entry.image;
+        }
+
+        // 모두 사용 중이면 새로 만듭니다. (풀이 차 있으면 이번 한 번만 쓰고 버립니다)
+        auto image = std::make_shared<mediapipe::ImageFrame>(mediapipe::ImageFormat::SRGB, width, height);
+        cv::Mat pixels(height, width, CV_8UC3, image->MutablePixelData(), image->WidthStep());
+        fill_outside(pixels, keep);
+        if (entries_.size() < kPoolSize) entries_.push_back({image, keep});
+        return image;
+    }
+
+private:
+    // 그래프 안(max_in_flight)과 콜백에 머무는 프레임 수보다 넉넉하게
+    static const size_t kPoolSize = 4;
+    struct Entry {
+        std::shared_ptr<mediapipe::ImageFrame> image;
+        cv::Rect last_roi;  // 마지막으로 쓴 (반전 후) 손 영역
+    };
+    std::vector<Entry> entries_;
+};
+
+VirtualTouchApp::VirtualTouchApp(const VirtualTouchOptions& options)
+    : options_(options), roi_frame_pool_(std::make_unique<RoiFramePool>()) {}
 VirtualTouchApp::~VirtualTouchApp() {
     // ✨ 스레드 종료 로직 제거
+    if(preview_) {
+        preview_->stop();
+    }
     if(landmarker_) {
         landmarker_->Close();
     }
+    // 콜백이 더 이상 오지 않은 뒤에 닫습니다.
+    if (results_event_fd_ >= 0) close(results_event_fd_);
+}
+
+void VirtualTouchApp::set_frame_source(std::unique_ptr<FrameSource> source) {
+    frame_source_ = std::move(source);
 }
 
 bool VirtualTouchApp::setup() {
-    webcam_ = std::make_unique<WebcamManager>(640, 480, 30);
-    if (!webcam_->initialize()) return false;
+    if (!frame_source_) {
+        DecodeOptions decode_options;
+        decode_options.decode_threads = options_.decode_threads;
+        decode_options.frame_threading = options_.decode_frame_threading;
+        decode_options.convert_threads = options_.convert_threads;
+        frame_source_ = std::make_unique<WebcamManager>(options_.camera_width, options_.camera_height, options_.camera_fps,
+                                                        options_.source, decode_options);
+    }
+    if (!frame_source_->initialize()) return false;
 
+    // inject_mouse 가 꺼져 있으면 초기화하지 않은 상태로 두어 모든 마우스 호출이 무시됩니다.
     mouse_controller_ = std::make_unique<MouseController>();
-    if (!mouse_controller_->initialize()) return false;
+    if (options_.inject_mouse && !mouse_controller_->initialize()) return false;
     
     gesture_controller_ = std::make_unique<GestureController>(*mouse_controller_);
+
+    results_event_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (results_event_fd_ < 0) {
+        std::cerr << "⛔ eventfd 생성 실패! (" << std::strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    pending_samples_.reserve(kMaxPendingSamples);
+    gesture_samples_.reserve(kMaxPendingSamples);
+
+    if (!options_.landmark_bus_name.empty()) {
+        landmark_bus_ = std::make_unique<LandmarkBusPublisher>();
+        if (!landmark_bus_->initialize(options_.landmark_bus_name)) return false;
+    }
     
     auto options = std::make_unique<mediapipe::tasks::vision::hand_landmarker::HandLandmarkerOptions>();
 
@@ -36,10 +207,11 @@ bool VirtualTouchApp::setup() {
     // --- ✨ ---
     
     // --- ✨ GPU 사용 설정 ---
-    options->base_options.delegate = mediapipe::tasks::core::BaseOptions::Delegate::GPU;
+    options->base_options.delegate = options_.use_gpu ? mediapipe::tasks::core::BaseOptions::Delegate::GPU
+                                                      : mediapipe::tasks::core::BaseOptions::Delegate::CPU;
     // --- ✨ ---
 
-    options->base_options.model_asset_path = "mediapipe/examples/desktop/my_virtual_touch/hand_landmarker.task";
+    options->base_options.model_asset_path = options_.model_path;
     options->running_mode = mediapipe::tasks::vision::core::RunningMode::LIVE_STREAM;
     options->num_hands = 1;
     
@@ -49,6 +221,10 @@ bool VirtualTouchApp::setup() {
             this->on_landmarks_detected(std::move(result), image, timestamp_ms);
         };
 
+    double anon_before_mb, file_before_mb;
+    resident_memory_mb(anon_before_mb, file_before_mb);
+    const int64_t create_start_ns = steady_now_ns();
+
     auto landmarker_result = mediapipe::tasks::vision::hand_landmarker::HandLandmarker::Create(std::move(options));
     if (!landmarker_result.ok()) {
         std::cerr << "⛔ HandLandmarker 생성 실패! " << landmarker_result.status() << std::endl;
@@ -56,109 +232,375 @@ bool VirtualTouchApp::setup() {
     }
     landmarker_ = std::move(landmarker_result.value());
 
+    double anon_after_mb, file_after_mb;
+    resident_memory_mb(anon_after_mb, file_after_mb);
+    std::cout << "🧠 모델 로드: "
+              << (steady_now_ns() - create_start_ns) / 1e6 << "ms, RSS 익명 +" << anon_after_mb - anon_before_mb
+              << "MB, 파일 +" << file_after_mb - file_before_mb << "MB" << std::endl;
+
     // ✨ 마우스 제어 스레드 시작 로직 제거
+
+    if (options_.show_preview) {
+        PreviewBackend backend;
+        if (!parse_preview_backend(options_.preview_backend, backend)) {
+            std::cerr << "⛔ 알 수 없는 미리보기 방식입니다! (" << options_.preview_backend << ")" << std::endl;
+            return false;
+        }
+        preview_ = std::make_unique<PreviewRenderer>(options_.preview_max_fps, options_.preview_scale, backend);
+        preview_->start();
+    }
     
     return true;
 }
 
 void VirtualTouchApp::run() {
-    auto prev_time = std::chrono::high_resolution_clock::now();
-    auto start_time_ = std::chrono::high_resolution_clock::now();
+    run_start_time_ = std::chrono::high_resolution_clock::now();
+    prev_frame_time_ = run_start_time_;
+    last_timestamp_ms_ = -1;
     std::cout << "🎬 가상 터치 시작... (q 키 또는 Ctrl+C로 종료)" << std::endl;
     // ✨ 마우스 제어 스레드 시작 알림 제거
-    
+
+    // ✨ 캡처 fd, 결과 eventfd, X 연결, 종료 시그널을 한 번에 기다립니다. 기다리는 동안 CPU 를 쓰지 않습니다.
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        std::cerr << "⛔ epoll 생성 실패! (" << std::strerror(errno) << ")" << std::endl;
+        return;
+    }
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    int signal_fd = signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC);
+
+    const int frame_fd = frame_source_->get_poll_fd();
+    if (frame_fd >= 0) watch_fd(epoll_fd, frame_fd, kFrameEvent);
+    watch_fd(epoll_fd, results_event_fd_, kResultEvent);
+    if (mouse_controller_->connection_fd() >= 0) watch_fd(epoll_fd, mouse_controller_->connection_fd(), kXEvent);
+    if (signal_fd >= 0) watch_fd(epoll_fd, signal_fd, kSignalEvent);
+
+    // fd 가 없는 소스(녹화 파일, 합성 소스)는 기다리지 않고 반복마다 프레임을 하나씩 처리합니다.
+    // (합성 소스는 grab() 안에서 다음 프레임 시각까지 잠듭니다)
+    const int timeout_ms = frame_fd >= 0 ? -1 : 0;
+    // 녹화 파일은 추론 자리가 없으면 결과 eventfd 가 깨울 때까지 잠듭니다. (제한 시간은 콜백이 끝내 오지 않는 경우 대비)
+    const bool wait_for_capacity = frame_fd < 0 && !frame_source_->is_live();
+
     cv::Mat frame;  //RGB 형식
-    while (true) {
+    last_hand_ns_ = steady_now_ns();
+    epoll_event events[4];
+    bool running = true;
+    while (running && !stop_requested_) {
+        const int wait_ms = wait_for_capacity && !has_inference_capacity() ? kReplayCapacityWaitMs : timeout_ms;
+        int count = epoll_wait(epoll_fd, events, 4, wait_ms);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "⛔ epoll_wait 실패! (" << std::strerror(errno) << ")" << std::endl;
+            break;
+        }
 
-        webcam_->get_next_frame(frame);
+        for (int i = 0; i < count && running; ++i) {
+            switch (events[i].data.u32) {
+                case kFrameEvent:
+                    if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                        std::cerr << "⛔ 캡처 장치 연결이 끊어졌습니다!" << std::endl;
+                        running = false;
+                    } else {
+                        running = process_frame(frame);
+                    }
+                    break;
+                case kResultEvent:
+                    process_results();
+                    break;
+                case kXEvent:
+                    mouse_controller_->process_events();
+                    break;
+                case kSignalEvent:
+                    if (process_signal(signal_fd)) running = false;
+                    break;
+            }
+        }
+        if (frame_fd < 0 && running && !stop_requested_) running = process_frame(frame);
+    }
 
-        // ✨ --- 최적화된 프레임 처리 로직 (이미지 전처리) --- ✨
-        auto now = std::chrono::high_resolution_clock::now();
-        int64_t timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - start_time_).count();
+    if (signal_fd >= 0) close(signal_fd);
+    close(epoll_fd);
 
-        // 1. MediaPipe가 사용할 최종 이미지 프레임을 먼저 생성합니다.
-        auto mp_image_frame = std::make_shared<mediapipe::ImageFrame>(
-            mediapipe::ImageFormat::SRGB, frame.cols, frame.rows);
-        
-        // 2. 위에서 만든 MediaPipe 프레임의 메모리 버퍼를 직접 가리키는 cv::Mat을 생성합니다.
-        cv::Mat destination_mat(frame.rows, frame.cols, CV_8UC3, mp_image_frame->MutablePixelData());
+    std::cout << "📊 프레임 통계: 제출 " << frames_submitted() << ", 사전 거부 " << frames_rejected()
+              << ", 그래프 내부 드롭 " << frames_dropped_in_graph() << ", 결과 " << results_received() << std::endl;
+    LatencyHistogram::Snapshot prep_full = take_prep_cost_snapshot(false);
+    LatencyHistogram::Snapshot prep_roi = take_prep_cost_snapshot(true);
+    std::cout << "🧮 프레임 준비: 전체 " << prep_full.total << " 프레임 p50 " << prep_full.percentile_us(0.50) << "us p99 "
+              << prep_full.percentile_us(0.99) << "us, ROI " << prep_roi.total << " 프레임 p50 "
+              << prep_roi.percentile_us(0.50) << "us p99 " << prep_roi.percentile_us(0.99) << "us" << std::endl;
+    if (options_.roi_tracking) {
+        const HandLossStats full = hand_loss_stats(false);
+        const HandLossStats roi = hand_loss_stats(true);
+        std::cout << "🤚 손 추적 연속성: 전체 프레임 " << full.lost << "/" << full.results << " 놓침, ROI "
+                  << roi.lost << "/" << roi.results << " 놓침" << std::endl;
+    }
+    if (preview_) {
+        LatencyHistogram::Snapshot cost = preview_->take_render_cost_snapshot();
+        std::cout << "🖼️ 미리보기 (" << options_.preview_backend << "): " << cost.total << " 프레임, 프레임당 렌더 스레드 CPU p50 "
+                  << cost.percentile_us(0.50) << "us, p99 " << cost.percentile_us(0.99) << "us" << std::endl;
+    }
+    std::cout << "🛑 프로그램 종료" << std::endl;
+}
 
-        // 3. 원본 웹캠 프레임(frame)을 좌우 반전시켜 destination_mat에 바로 씁니다.
-        cv::flip(frame, destination_mat, 1);
-        
-        mediapipe::Image mp_image(mp_image_frame);
+void VirtualTouchApp::stop() {
+    stop_requested_ = true;
+    notify_event_fd(results_event_fd_);
+}
 
-        
-        // 비동기 랜드마크 감지를 호출합니다. (이미지 전처리는 여기서 끝)
-        landmarker_->DetectAsync(mp_image, timestamp_ms);
+bool VirtualTouchApp::process_frame(cv::Mat& frame) {
+    // 녹화 파일은 추론 자리가 날 때까지 다음 프레임을 읽지 않습니다. 여기서 버리면 처리되는 프레임이
+    // 추론 속도에 따라 달라져서 같은 파일로 돌린 결과를 비교할 수 없습니다.
+    if (!frame_source_->is_live() && !has_inference_capacity()) return true;
 
-        // 랜드마크 결과를 가져와 화면에 그릴 준비를 합니다. (화면 출력은 메인 스레드에서 계속)
-        std::vector<mediapipe::tasks::components::containers::NormalizedLandmark> landmarks_to_draw;
+    // 다음 패킷만 받아두고, 실제로 쓸 프레임일 때만 디코딩/변환합니다.
+    if (!frame_source_->grab()) return !frame_source_->at_end();
+
+    // ✨ 유휴 상태에서는 idle_inference_interval 프레임 중 하나만 처리하고 나머지는 변환 없이 버립니다.
+    update_idle_state();
+    if (idle_ && (idle_frame_count_++ % options_.idle_inference_interval) != 0) {
+        frame_source_->discard();
+        return true;
+    }
+
+    // ✨ 추론 중인 프레임이 max_in_flight 개 이상이면 그래프의 flow limiter 가 어차피 버릴 프레임이므로
+    // 변환/반전/복사를 하기 전에 여기서 버립니다. (실시간 소스만, 녹화 파일은 위에서 기다림)
+    if (!has_inference_capacity()) {
+        frame_source_->discard();
+        frames_rejected_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // ✨ ROI 추적: 직전 결과에 손이 있으면 그 주변만 변환/반전합니다.
+    // (주기적으로, 손을 놓치면, 미리보기가 프레임을 받을 차례면 전체 프레임)
+    // 추론에 넘기는 이미지는 어느 쪽이든 전체 프레임 크기라서, 그래프가 직전 결과로 잡아 둔 추적 영역(정규화 좌표)이
+    // ROI 패스와 전체 패스를 오가도 같은 화면 위치를 가리킵니다. 랜드마크도 좌표 변환 없이 그대로 씁니다.
+    const bool preview_due = preview_ && preview_->wants_frame();
+    const int frame_width = frame_source_->get_width();
+    const int frame_height = frame_source_->get_height();
+    cv::Rect roi;
+    bool use_roi = false;
+    if (options_.roi_tracking && options_.roi_full_frame_interval > 1 &&
+        (roi_frame_count_++ % options_.roi_full_frame_interval) != 0 && !preview_due) {
+        HandSample last_sample;
         {
             std::lock_guard<std::mutex> lock(landmarks_mutex_);
-            landmarks_to_draw = latest_landmarks_;
+            last_sample = latest_sample_;
         }
-        
-        // 화면에 그리는 작업은 destination_mat을 사용합니다.
-        if (!landmarks_to_draw.empty()) {
-            for(const auto& landmark : landmarks_to_draw){
-                cv::circle(destination_mat, cv::Point(landmark.x * destination_mat.cols, landmark.y * destination_mat.rows), 5, cv::Scalar(255,0,255), cv::FILLED);
-            }
+        use_roi = last_sample.has_hand() &&
+                  hand_region(last_sample, frame_width, frame_height, options_.roi_margin, roi);
+    }
+
+    const int64_t prep_start_ns = steady_now_ns();
+    if (!(use_roi ? frame_source_->retrieve_region(roi, frame) : frame_source_->retrieve(frame))) return true;
+    const int image_width = use_roi ? frame_width : frame.cols;
+    const int image_height = use_roi ? frame_height : frame.rows;
+
+    // ✨ --- 최적화된 프레임 처리 로직 (이미지 전처리) --- ✨
+    auto now = std::chrono::high_resolution_clock::now();
+    int64_t timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - run_start_time_).count();
+    // LIVE_STREAM 모드는 타임스탬프가 단조 증가해야 합니다. (리플레이는 1ms 안에 여러 프레임이 올 수 있음)
+    if (timestamp_ms <= last_timestamp_ms_) timestamp_ms = last_timestamp_ms_ + 1;
+    last_timestamp_ms_ = timestamp_ms;
+
+    // 1. MediaPipe가 사용할 최종 이미지 프레임을 먼저 생성합니다.
+    // ROI 패스면 frame 은 손 영역뿐이므로 반전한 이미지에서의 같은 위치만 쓰고, 나머지가 검게 채워진 프레임을 풀에서 받습니다.
+    const cv::Rect mirrored = use_roi ? cv::Rect(frame_width - (roi.x + roi.width), roi.y, roi.width, roi.height) : cv::Rect();
+    std::shared_ptr<mediapipe::ImageFrame> mp_image_frame =
+        use_roi ? roi_frame_pool_->acquire(image_width, image_height, mirrored)
+                : std::make_shared<mediapipe::ImageFrame>(mediapipe::ImageFormat::SRGB, image_width, image_height);
+
+    // 2. 위에서 만든 MediaPipe 프레임의 메모리 버퍼를 직접 가리키는 cv::Mat을 생성합니다.
+    cv::Mat destination_mat(image_height, image_width, CV_8UC3, mp_image_frame->MutablePixelData(),
+                            mp_image_frame->WidthStep());
+
+    // 3. 원본 웹캠 프레임(frame)을 좌우 반전시켜 destination_mat에 바로 씁니다.
+    if (use_roi) {
+        cv::Mat destination_roi = destination_mat(mirrored);
+        cv::flip(frame, destination_roi, 1);
+    } else {
+        cv::flip(frame, destination_mat, 1);
+    }
+
+    mediapipe::Image mp_image(mp_image_frame);
+    (use_roi ? prep_cost_roi_ : prep_cost_full_).record(steady_now_ns() - prep_start_ns);
+
+    // 비동기 랜드마크 감지를 호출합니다. (이미지 전처리는 여기서 끝)
+    {
+        std::lock_guard<std::mutex> lock(in_flight_mutex_);
+        const int64_t submit_ns = steady_now_ns();
+        in_flight_.push_back({timestamp_ms, submit_ns, use_roi});
+        if (idle_) idle_sample_ns_[idle_sample_count_++ % kIdleSampleHistory] = submit_ns;
+    }
+    auto detect_status = landmarker_->DetectAsync(mp_image, timestamp_ms);
+    if (!detect_status.ok()) {
+        std::cerr << "⚠️ DetectAsync 실패: " << detect_status << std::endl;
+        std::lock_guard<std::mutex> lock(in_flight_mutex_);
+        if (!in_flight_.empty() && in_flight_.back().timestamp_ms == timestamp_ms) {
+            in_flight_.pop_back();
         }
-        // ✨ --- 로직 종료 --- ✨
+        return true;
+    }
+    frames_submitted_.fetch_add(1, std::memory_order_relaxed);
 
-        // 화면 표시(imshow)를 위해 RGB 이미지를 BGR로 변환합니다.
-        cv::Mat bgr_display_frame;
-        cv::cvtColor(destination_mat, bgr_display_frame, cv::COLOR_RGB2BGR);
+    // FPS 계산
+    auto curr_time = std::chrono::high_resolution_clock::now();
+    double fps = 1.0 / std::chrono::duration_cast<std::chrono::duration<double>>(curr_time - prev_frame_time_).count();
+    prev_frame_time_ = curr_time;
 
+    // ✨ 미리보기는 렌더러 스레드가 그립니다. 여기서는 차례가 된 프레임의 포인터만 넘깁니다.
+    // (ImageFrame 은 DetectAsync 이후 수정하지 않으므로 그대로 공유해도 안전합니다)
+    // 미리보기 차례인 프레임은 위에서 전체 프레임으로 변환했으므로 ROI 추적 중에도 max_fps 대로 갱신됩니다.
+    if (preview_) {
+        if (preview_->quit_requested()) return false;
+        if (preview_due) {
+            std::lock_guard<std::mutex> lock(landmarks_mutex_);
+            preview_->submit(mp_image_frame, latest_sample_, fps);
+        }
+    }
+    return true;
+}
 
-        // FPS 계산 및 표시
-        auto curr_time = std::chrono::high_resolution_clock::now();
-        double fps = 1.0 / std::chrono::duration_cast<std::chrono::duration<double>>(curr_time - prev_time).count();
-        prev_time = curr_time;
-        cv::putText(bgr_display_frame, std::to_string(static_cast<int>(fps)), cv::Point(20, 50), cv::FONT_HERSHEY_PLAIN, 3, cv::Scalar(0, 255, 0), 3);
-        
-        // 최종 결과 이미지를 화면에 보여줍니다.
-        cv::imshow("Virtual Touch C++", bgr_display_frame);
-        if (cv::waitKey(1) == 'q') break;
-        
+void VirtualTouchApp::process_results() {
+    uint64_t count = 0;
+    if (read(results_event_fd_, &count, sizeof(count)) != sizeof(count)) return;
+    {
+        std::lock_guard<std::mutex> lock(landmarks_mutex_);
+        gesture_samples_.swap(pending_samples_);
     }
-    std::cout << "🛑 프로그램 종료" << std::endl;
+
+    // 제스처 분석/마우스 제어는 X 연결을 쓰는 이 스레드에서만 합니다.
+    for (const HandSample& sample : gesture_samples_) {
+        if (sample.has_hand()) gesture_controller_->handle_gestures(sample);
+
+        if (landmark_bus_) {
+            LandmarkBusRecord record;
+            record.sample = sample;
+            record.finger_mask = sample.has_hand() ? gesture_controller_->last_finger_mask() : 0;
+            record.publish_ns = steady_now_ns();
+            landmark_bus_->publish(record);
+        }
+    }
+    gesture_samples_.clear();
+}
+
+bool VirtualTouchApp::process_signal(int signal_fd) {
+    signalfd_siginfo info{};
+    if (read(signal_fd, &info, sizeof(info)) != sizeof(info)) return false;
+    std::cout << "🛑 종료 신호 수신 (" << strsignal(info.ssi_signo) << ")" << std::endl;
+    return true;
+}
+
+bool VirtualTouchApp::has_inference_capacity() {
+    std::lock_guard<std::mutex> lock(in_flight_mutex_);
+    // 콜백이 끝내 오지 않은 제출은 일정 시간이 지나면 그래프가 버린 것으로 보고 정리합니다.
+    const int64_t now_ms = pipeline_now_ms();
+    while (!in_flight_.empty() && now_ms - in_flight_.front().timestamp_ms > kInFlightTimeoutMs) {
+        in_flight_.pop_front();
+        frames_dropped_in_graph_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return static_cast<int>(in_flight_.size()) < options_.max_in_flight;
+}
+
+int64_t VirtualTouchApp::pipeline_now_ms() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::high_resolution_clock::now() - run_start_time_).count();
+}
+
+void VirtualTouchApp::complete_in_flight(int64_t timestamp_ms, bool& roi, int64_t& submit_ns) {
+    // 결과는 타임스탬프 순서로 나오므로, 이 결과보다 앞선 제출은 그래프 안에서 버려진 것입니다.
+    std::lock_guard<std::mutex> lock(in_flight_mutex_);
+    while (!in_flight_.empty() && in_flight_.front().timestamp_ms <= timestamp_ms) {
+        if (in_flight_.front().timestamp_ms < timestamp_ms) {
+            frames_dropped_in_graph_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            latency_histogram_.record(steady_now_ns() - in_flight_.front().submit_ns);
+            roi = in_flight_.front().roi;
+            submit_ns = in_flight_.front().submit_ns;
+        }
+        in_flight_.pop_front();
+    }
+}
+
+void VirtualTouchApp::update_idle_state() {
+    if (options_.idle_timeout_sec <= 0 || options_.idle_inference_interval <= 1) return;
+
+    int64_t now_ns = steady_now_ns();
+    int64_t last_hand_ns = last_hand_ns_.load(std::memory_order_relaxed);
+    bool should_idle = (now_ns - last_hand_ns) > static_cast<int64_t>(options_.idle_timeout_sec * 1e9);
+    if (should_idle == idle_) return;
+
+    double cpu_sec = process_cpu_seconds();
+    if (should_idle) {
+        idle_enter_ns_ = now_ns;
+        idle_enter_cpu_sec_ = cpu_sec;
+        idle_frame_count_ = 0;
+        std::fill(std::begin(idle_sample_ns_), std::end(idle_sample_ns_), 0);
+        std::cout << "💤 유휴 상태 진입 (" << options_.idle_inference_interval << " 프레임마다 1회 추론)" << std::endl;
+    } else {
+        // 복귀 지연: 손이 화면에 들어온 뒤 전체 속도로 돌아오기까지. 손은 손이 없던 직전 샘플 프레임 이후
+        // 언제든 들어왔을 수 있으므로 그 샘플부터 잰 값(최대)이며, 솎아내기 + 추론 + 루프 대기로 나눠 보여줍니다.
+        const int64_t hand_frame_ns = last_hand_frame_ns_.load(std::memory_order_relaxed);
+        int64_t window_start_ns = 0;
+        for (int64_t sample_ns : idle_sample_ns_) {
+            if (sample_ns < hand_frame_ns && sample_ns > window_start_ns) window_start_ns = sample_ns;
+        }
+        if (window_start_ns == 0) window_start_ns = hand_frame_ns;  // 손이 나온 프레임이 유휴 후 첫 샘플
+
+        double idle_sec = (now_ns - idle_enter_ns_) / 1e9;
+        double idle_cpu_percent = idle_sec > 0 ? 100.0 * (cpu_sec - idle_enter_cpu_sec_) / idle_sec : 0.0;
+        double decimation_ms = (hand_frame_ns - window_start_ns) / 1e6;
+        double inference_ms = (last_hand_ns - hand_frame_ns) / 1e6;
+        double loop_ms = (now_ns - last_hand_ns) / 1e6;
+        std::cout << "⚡ 손 감지, 전체 속도로 복귀 (유휴 " << idle_sec << "s, 평균 CPU " << idle_cpu_percent
+                  << "%, 복귀 지연 최대 " << decimation_ms + inference_ms + loop_ms << "ms = 솎아낸 프레임 "
+                  << decimation_ms << "ms + 추론 " << inference_ms << "ms + 루프 " << loop_ms << "ms)" << std::endl;
+    }
+    idle_ = should_idle;
 }
 
 void VirtualTouchApp::on_landmarks_detected(
     absl::StatusOr<mediapipe::tasks::vision::hand_landmarker::HandLandmarkerResult> result,
     const mediapipe::Image& image, int64_t timestamp_ms) {
 
+    bool roi = false;
+    int64_t submit_ns = 0;
+    complete_in_flight(timestamp_ms, roi, submit_ns);
     if (!result.ok()) {
         return;
     }
-    
-    if (!result->hand_landmarks.empty()) {
-        
-        // ✨ --- 제스처 분석 및 마우스 제어 로직 통합 --- ✨
-        if (!result->handedness.empty() && !result->handedness[0].categories.empty()) {
-            std::string hand_label = *result->handedness[0].categories[0].category_name;
+    results_received_.fetch_add(1, std::memory_order_relaxed);
 
-            const auto& landmarks = result->hand_landmarks[0].landmarks;
-            
+    // ✨ MediaPipe 경계: 결과를 여기서 한 번만 HandSample 로 바꾸고, 이후에는 이 고정 크기 값만 복사합니다.
+    const HandSample sample = to_hand_sample(*result, timestamp_ms);
 
-            // MediaPipe 내부 스레드에서 즉시 제스처 분석 및 마우스 제어 실행
-            gesture_controller_->handle_gestures(landmarks, hand_label);
+    // 손 추적 연속성: 직전 결과에 손이 있었다면 이번 프레임 종류(ROI/전체)에 결과를 세고, 놓쳤으면 따로 셉니다.
+    if (prev_result_had_hand_ && submit_ns != 0) {
+        HandLossCounters& counters = roi ? hand_loss_roi_ : hand_loss_full_;
+        counters.results.fetch_add(1, std::memory_order_relaxed);
+        if (!sample.has_hand()) counters.lost.fetch_add(1, std::memory_order_relaxed);
+    }
+    prev_result_had_hand_ = sample.has_hand();
 
-            // 화면 그리기를 위해 랜드마크 저장
-            std::lock_guard<std::mutex> lock(landmarks_mutex_);
-            latest_landmarks_ = landmarks;
-            latest_hand_label_ = hand_label;
-        }
-        // ✨ --- 통합 완료 --- ✨
+    if (sample.has_hand()) {
+        const int64_t now_ns = steady_now_ns();
+        last_hand_frame_ns_.store(submit_ns ? submit_ns : now_ns, std::memory_order_relaxed);
+        last_hand_ns_.store(now_ns, std::memory_order_relaxed);
+    }
+    if (result_listener_) result_listener_(sample);
 
-    } else {
-        // 손이 감지되지 않으면 랜드마크를 지웁니다.
+    {
+        // 화면 그리기를 위해 저장합니다. (손이 없으면 NONE 샘플로 덮어써서 지워집니다)
         std::lock_guard<std::mutex> lock(landmarks_mutex_);
-        latest_landmarks_.clear();
-        latest_hand_label_ = "";
-    }   
+        latest_sample_ = sample;
+
+        // 제스처 분석/마우스 제어/버스 게시는 run() 스레드로 넘깁니다. 루프가 밀리면 오래된 결과부터 버립니다.
+        if (pending_samples_.size() >= kMaxPendingSamples) pending_samples_.erase(pending_samples_.begin());
+        pending_samples_.push_back(sample);
+    }
+    notify_event_fd(results_event_fd_);
 }
 
 // ✨ mouse_control_thread_func 함수 제거
\ No newline at end of file
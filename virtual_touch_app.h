@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 #include <chrono> 
+#include <deque>
 // #include <thread> // 제거
 // #include <condition_variable> // 제거
 // #include <atomic> // 제거
@@ -20,26 +24,123 @@
 #undef COUNT 
 
 #include "mediapipe/framework/formats/image.h"
-#include "mediapipe/tasks/cc/components/containers/landmark.h"
 #include "mediapipe/tasks/cc/vision/hand_landmarker/hand_landmarker.h"
 
+#include "hand_sample.h"
+#include "latency_histogram.h"
+#include "model_path.h"
+
 // Forward declarations
-class WebcamManager;
+namespace cv { class Mat; }
+class FrameSource;
 class MouseController;
 class GestureController;
+class PreviewRenderer;
+class LandmarkBusPublisher;
+
+// 실행 옵션 (main.cpp 의 플래그에서 채워집니다)
+struct VirtualTouchOptions {
+    int camera_width = 640;
+    int camera_height = 480;
+    int camera_fps = 30;
+    // v4l2 장치 경로 또는 녹화 파일 경로 (파일이면 끝까지 재생 후 run() 이 반환됩니다)
+    std::string source = "/dev/video0";
+
+    // 디코딩/RGB 변환 스레드 (1080p 이상 카메라용, webcam_manager.h 의 DecodeOptions 참고)
+    int decode_threads = 1;               // 0 = 코어 수에 맞춰 자동
+    bool decode_frame_threading = false;  // 처리량은 늘지만 (스레드 수 - 1) 프레임 지연이 생깁니다
+    int convert_threads = 1;
+
+    bool use_gpu = true;
+
+    // 모델 파일 경로 (MediaPipe 가 읽기 전용으로 mmap 합니다)
+    std::string model_path = kDefaultModelPath;
+    // false 면 X 서버에 연결하지 않고 마우스 이벤트를 보내지 않습니다. (벤치마크/분석용)
+    bool inject_mouse = true;
+
+    // 미리보기 창: 별도 스레드에서 preview_max_fps 이하로만 그립니다.
+    bool show_preview = true;
+    double preview_max_fps = 15.0;
+    double preview_scale = 1.0;  // 1.0 미만이면 축소해서 표시
+    // "highgui" (cv::imshow) 또는 "xshm" (MIT-SHM 공유 이미지에 바로 그림, 로컬 X 서버 전용)
+    std::string preview_backend = "highgui";
+
+    // 유휴 상태: 손이 idle_timeout_sec 동안 없으면 idle_inference_interval 프레임마다 한 번만 추론합니다.
+    // (나머지 프레임은 변환 없이 버림, 0 이하면 비활성화)
+    double idle_timeout_sec = 5.0;
+    int idle_inference_interval = 6;
+
+    // 비어있지 않으면 결과를 이 이름의 POSIX 공유 메모리 링 버퍼로 게시합니다. (예: "/virtual_touch_landmarks")
+    std::string landmark_bus_name;
+
+    // 동시에 추론 중일 수 있는 프레임 수. 이보다 많으면 새 프레임은 변환 전에 버립니다.
+    // (LIVE_STREAM 그래프의 flow limiter 도 기본적으로 1 개만 받습니다)
+    int max_in_flight = 1;
+
+    // ROI 추적: 직전 결과에 손이 있으면 그 경계 상자 + 여백 영역만 변환/반전하고 나머지는 검게 채워 추론에 넘깁니다.
+    // 이미지 크기와 좌표계는 전체 프레임 그대로라 그래프의 손 추적이 끊기지 않습니다.
+    // roi_full_frame_interval 프레임마다 한 번, 손을 놓쳤을 때, 미리보기 프레임 차례일 때는 전체 프레임을 변환합니다.
+    bool roi_tracking = false;
+    double roi_margin = 0.5;  // 경계 상자 긴 변 대비 한쪽 여백 비율
+    int roi_full_frame_interval = 15;
+};
 
 class VirtualTouchApp {
 public:
-    VirtualTouchApp();
+    explicit VirtualTouchApp(const VirtualTouchOptions& options = VirtualTouchOptions());
     ~VirtualTouchApp();
 
+    // 랜드마크 결과가 나올 때마다 MediaPipe 스레드에서 호출됩니다. (setup() 전에 등록)
+    // 손이 없는 프레임은 sample.has_hand() == false 로 전달됩니다.
+    // 제스처/마우스 처리와 랜드마크 버스 게시는 이와 별개로 run() 스레드에서 이뤄집니다.
+    using ResultListener = std::function<void(const HandSample& sample)>;
+
+    // setup() 전에 호출하면 웹캠 대신 이 소스에서 프레임을 받습니다. (합성 소스, soak 테스트 등)
+    void set_frame_source(std::unique_ptr<FrameSource> source);
+
     bool setup();
+    // 이벤트 루프: 캡처 fd, 결과 eventfd, X 연결, SIGINT/SIGTERM(signalfd) 을 epoll 로 기다리며 처리합니다.
+    // 시그널은 호출하는 쪽이 모든 스레드에서 막아 두었을 때만 여기로 옵니다. (main.cpp 참고)
     void run();
+    // 다른 스레드에서 run() 루프를 끝냅니다.
+    void stop();
+
+    void set_result_listener(ResultListener listener) { result_listener_ = std::move(listener); }
+    int64_t frames_submitted() const { return frames_submitted_.load(std::memory_order_relaxed); }
+    int64_t results_received() const { return results_received_.load(std::memory_order_relaxed); }
+    // 추론 여유가 없어 변환 전에 버린 프레임 / 제출했지만 그래프 안에서 결과 없이 버려진 프레임
+    int64_t frames_rejected() const { return frames_rejected_.load(std::memory_order_relaxed); }
+    int64_t frames_dropped_in_graph() const { return frames_dropped_in_graph_.load(std::memory_order_relaxed); }
+    // 제출(DetectAsync)부터 결과 콜백까지의 지연 분포. 가져가면서 0 으로 초기화됩니다.
+    LatencyHistogram::Snapshot take_latency_snapshot() { return latency_histogram_.take(); }
+    // 프레임 준비(변환 + 반전 + ImageFrame 복사) 시간 분포. roi 가 true 면 손 영역만 변환한 프레임만.
+    LatencyHistogram::Snapshot take_prep_cost_snapshot(bool roi) { return roi ? prep_cost_roi_.take() : prep_cost_full_.take(); }
+
+    // 손 추적 연속성: 직전 결과에 손이 있었는데 이번 결과에서 놓친 횟수를 프레임 종류(ROI/전체)별로 셉니다.
+    struct HandLossStats {
+        int64_t results = 0;  // 직전 결과에 손이 있었던 결과 수
+        int64_t lost = 0;     // 그중 손을 놓친 수
+    };
+    HandLossStats hand_loss_stats(bool roi) const {
+        const HandLossCounters& counters = roi ? hand_loss_roi_ : hand_loss_full_;
+        return {counters.results.load(std::memory_order_relaxed), counters.lost.load(std::memory_order_relaxed)};
+    }
 
 private:
     void on_landmarks_detected(
         absl::StatusOr<mediapipe::tasks::vision::hand_landmarker::HandLandmarkerResult> result,
         const mediapipe::Image& image, int64_t timestamp_ms);
+    void update_idle_state();
+
+    // run() 의 이벤트 처리기 (모두 run() 스레드에서 호출)
+    bool process_frame(cv::Mat& frame);  // false 면 루프 종료 (파일 끝, 미리보기에서 종료)
+    void process_results();
+    bool process_signal(int signal_fd);  // 종료 신호면 true
+
+    bool has_inference_capacity();
+    // 결과가 나온 제출을 정리하고, 그 프레임이 ROI 패스였는지와 제출 시각을 돌려줍니다. (기록이 없으면 submit_ns 는 0)
+    void complete_in_flight(int64_t timestamp_ms, bool& roi, int64_t& submit_ns);
+    int64_t pipeline_now_ms() const;
 
     // 마우스 제어 스레드 관련 멤버 모두 제거
     // void mouse_control_thread_func(); // 제거
@@ -49,12 +150,73 @@ private:
     // bool new_landmarks_available_ = false; // 제거
     // std::string latest_hand_label_ = ""; // 제거
 
-    std::unique_ptr<WebcamManager> webcam_;
+    VirtualTouchOptions options_;
+
+    std::unique_ptr<FrameSource> frame_source_;
     std::unique_ptr<MouseController> mouse_controller_;
     std::unique_ptr<GestureController> gesture_controller_;
     std::unique_ptr<mediapipe::tasks::vision::hand_landmarker::HandLandmarker> landmarker_;
+    std::unique_ptr<PreviewRenderer> preview_;
+    std::unique_ptr<LandmarkBusPublisher> landmark_bus_;
+    ResultListener result_listener_;
+
+    // 유휴 상태 관련 (idle_ 이하는 run() 스레드 전용)
+    std::atomic<int64_t> last_hand_ns_{0};        // 손이 나온 마지막 결과를 받은 시각
+    std::atomic<int64_t> last_hand_frame_ns_{0};  // 그 결과의 프레임을 제출한 시각
+    bool idle_ = false;
+    int64_t idle_frame_count_ = 0;
+    int64_t idle_enter_ns_ = 0;
+    double idle_enter_cpu_sec_ = 0.0;
+    // 유휴 중 추론에 넘긴 최근 프레임의 제출 시각. 복귀할 때 손이 나온 프레임 직전 샘플을 찾아
+    // 그 사이(솎아낸 프레임 구간)를 복귀 지연에 더합니다.
+    static const int kIdleSampleHistory = 4;
+    int64_t idle_sample_ns_[kIdleSampleHistory] = {};
+    int64_t idle_sample_count_ = 0;
+
+    // 제출 후 아직 콜백이 오지 않은 프레임 (오래된 순)
+    struct InFlightFrame {
+        int64_t timestamp_ms;
+        int64_t submit_ns;
+        bool roi;  // 손 영역만 변환한 프레임인지
+    };
+    static const int64_t kInFlightTimeoutMs = 1000;
+    std::mutex in_flight_mutex_;
+    std::deque<InFlightFrame> in_flight_;
+    LatencyHistogram latency_histogram_;
+    std::chrono::high_resolution_clock::time_point run_start_time_;
+
+    // 프레임 처리 상태 (run() 스레드 전용)
+    int64_t last_timestamp_ms_ = -1;
+    std::chrono::high_resolution_clock::time_point prev_frame_time_;
+    int64_t roi_frame_count_ = 0;
+    LatencyHistogram prep_cost_full_;
+    LatencyHistogram prep_cost_roi_;
+    // ROI 패스용 ImageFrame 재사용 풀 (정의는 virtual_touch_app.cpp)
+    class RoiFramePool;
+    std::unique_ptr<RoiFramePool> roi_frame_pool_;
+
+    // 손 추적 연속성 (콜백 스레드가 쓰고 다른 스레드가 읽음)
+    struct HandLossCounters {
+        std::atomic<int64_t> results{0};
+        std::atomic<int64_t> lost{0};
+    };
+    HandLossCounters hand_loss_full_;
+    HandLossCounters hand_loss_roi_;
+    bool prev_result_had_hand_ = false;  // 콜백 스레드 전용
+
+    // 결과 콜백(MediaPipe 스레드)과 stop() 이 여기에 써서 run() 을 깨웁니다.
+    int results_event_fd_ = -1;
+
+    std::atomic<bool> stop_requested_{false};
+    std::atomic<int64_t> frames_submitted_{0};
+    std::atomic<int64_t> results_received_{0};
+    std::atomic<int64_t> frames_rejected_{0};
+    std::atomic<int64_t> frames_dropped_in_graph_{0};
     
     std::mutex landmarks_mutex_;
-    std::vector<mediapipe::tasks::components::containers::NormalizedLandmark> latest_landmarks_;
-    std::string latest_hand_label_ = ""; // ✨ 화면 출력을 위해 레이블은 남겨둡니다.
+    HandSample latest_sample_;  // ✨ 화면 출력을 위해 마지막 결과를 남겨둡니다.
+    // 콜백 → run() 스레드로 넘기는 결과. run() 쪽 버퍼와 swap 해서 주고받으므로 평소에는 재할당이 없습니다.
+    static const size_t kMaxPendingSamples = 16;
+    std::vector<HandSample> pending_samples_;
+    std::vector<HandSample> gesture_samples_;  // run() 스레드 전용
 };
\ No newline at end of file
@@ -0,0 +1,212 @@
+// virtual_touch_pybind.cpp
+// C++ 파이프라인(WebcamManager → HandLandmarker → GestureController → MouseController)을
+// Python 모듈 virtual_touch_cc 로 노출합니다.
+// 프레임 루프/변환/마우스 입력은 모두 C++ 에서 GIL 없이 돌고, Python 은 결과만 읽어갑니다.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "virtual_touch_app.h"
+#include "gesture_batch.h"
+
+namespace py = pybind11;
+
+namespace {
+
+// run() 이 Python 시그널(Ctrl+C)을 확인하는 주기
+const std::chrono::milliseconds kSignalCheckInterval(100);
+
+// 결과 하나의 불변 스냅샷. Python 에 넘기는 NumPy 배열은 sample.landmarks 를 복사 없이 가리킵니다.
+struct LandmarkSnapshot {
+    HandSample sample;
+};
+
+class PyPipeline {
+public:
+    explicit PyPipeline(const VirtualTouchOptions& options)
+        : app_(std::make_unique<VirtualTouchApp>(options)) {
+        app_->set_result_listener([this](const HandSample& sample) {
+            auto snapshot = std::make_shared<LandmarkSnapshot>();
+            snapshot->sample = sample;
+            std::atomic_store(&latest_, std::shared_ptr<const LandmarkSnapshot>(std::move(snapshot)));
+        });
+    }
+
+    ~PyPipeline() { stop(); }
+
+    bool setup() { return app_->setup(); }
+
+    // 루프가 끝날 때까지 기다립니다. (파일 리플레이면 끝까지 처리 후 반환)
+    // Python 은 시그널 핸들러를 메인 스레드에서 GIL 을 잡았을 때만 실행하고, SIGINT 를 막지 않으므로
+    // 루프의 signalfd 로도 오지 않습니다. 그래서 루프는 작업 스레드에서 돌리고, 호출한 스레드는 주기적으로
+    // GIL 을 잡아 PyErr_CheckSignals() 를 부릅니다. KeyboardInterrupt 면 루프를 멈추고 예외를 그대로 올립니다.
+    // (GIL 을 놓은 상태로 불려야 합니다: call_guard<gil_scoped_release>)
+    void run() {
+        start();
+        std::unique_lock<std::mutex> lock(loop_mutex_);
+        while (!loop_cv_.wait_for(lock, kSignalCheckInterval, [this] { return loop_done_; })) {
+            lock.unlock();
+            bool interrupted;
+            {
+                py::gil_scoped_acquire gil;
+                interrupted = PyErr_CheckSignals() != 0;
+            }
+            if (interrupted) {
+                stop();
+                py::gil_scoped_acquire gil;
+                throw py::error_already_set();
+            }
+            lock.lock();
+        }
+        lock.unlock();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    // 백그라운드 스레드에서 루프를 돌립니다.
+    void start() {
+        if (worker_.joinable()) return;
+        loop_done_ = false;
+        worker_ = std::thread([this] {
+            app_->run();
+            {
+                std::lock_guard<std::mutex> lock(loop_mutex_);
+                loop_done_ = true;
+            }
+            loop_cv_.notify_all();
+        });
+    }
+
+    void stop() {
+        app_->stop();
+        if (worker_.joinable()) worker_.join();
+    }
+
+    // 최신 랜드마크 (21, 3) float32 배열. 손이 없으면 None.
+    // 배열은 스냅샷 버퍼를 직접 참조하며, 배열이 살아있는 동안 스냅샷도 유지됩니다. (읽기 전용)
+    py::object landmarks() const {
+        std::shared_ptr<const LandmarkSnapshot> snapshot = std::atomic_load(&latest_);
+        if (!snapshot || !snapshot->sample.has_hand()) return py::none();
+
+        auto* holder = new std::shared_ptr<const LandmarkSnapshot>(snapshot);
+        py::capsule owner(holder, [](void* p) {
+            delete static_cast<std::shared_ptr<const LandmarkSnapshot>*>(p);
+        });
+        py::array_t<float> array({HandSample::NUM_LANDMARKS, 3},
+                                 {3 * sizeof(float), sizeof(float)},
+                                 &snapshot->sample.landmarks[0][0], owner);
+        array.attr("setflags")(py::arg("write") = false);
+        return std::move(array);
+    }
+
+    std::string hand_label() const {
+        std::shared_ptr<const LandmarkSnapshot> snapshot = std::atomic_load(&latest_);
+        return snapshot ? handedness_label(snapshot->sample.handedness) : "";
+    }
+
+    int64_t timestamp_ms() const {
+        std::shared_ptr<const LandmarkSnapshot> snapshot = std::atomic_load(&latest_);
+        return snapshot ? snapshot->sample.timestamp_ms : -1;
+    }
+
+    int64_t frames_submitted() const { return app_->frames_submitted(); }
+    int64_t results_received() const { return app_->results_received(); }
+    int64_t frames_rejected() const { return app_->frames_rejected(); }
+    int64_t frames_dropped_in_graph() const { return app_->frames_dropped_in_graph(); }
+
+private:
+    std::unique_ptr<VirtualTouchApp> app_;
+    std::thread worker_;
+    std::mutex loop_mutex_;
+    std::condition_variable loop_cv_;
+    bool loop_done_ = false;
+    std::shared_ptr<const LandmarkSnapshot> latest_;
+};
+
+// (N, 21, 3) 랜드마크와 (N,) 오른손 여부로 손가락 마스크 (N,) 를 계산합니다.
+py::array_t<uint8_t> classify_fingers(
+    py::array_t<float, py::array::c_style | py::array::forcecast> landmarks,
+    py::array_t<uint8_t, py::array::c_style | py::array::forcecast> is_right) {
+    if (landmarks.ndim() != 3 || landmarks.shape(1) != 21 || landmarks.shape(2) < 2) {
+        throw std::invalid_argument("landmarks 는 (N, 21, 3) 배열이어야 합니다.");
+    }
+    const size_t n = static_cast<size_t>(landmarks.shape(0));
+    if (is_right.ndim() != 1 || static_cast<size_t>(is_right.shape(0)) != n) {
+        throw std::invalid_argument("is_right 는 (N,) 배열이어야 합니다.");
+    }
+
+    py::array_t<uint8_t> masks(n);
+    const float* src = landmarks.data();
+    const size_t stride = static_cast<size_t>(landmarks.shape(2));
+    const uint8_t* hands = is_right.data();
+    uint8_t* out = masks.mutable_data();
+    {
+        py::gil_scoped_release release;
+        LandmarkTraceSoA trace;
+        trace.resize(n);
+        for (size_t f = 0; f < n; ++f) {
+            const float* frame = src + f * 21 * stride;
+            for (int i = 0; i < 21; ++i) {
+                trace.x[i][f] = frame[i * stride];
+                trace.y[i][f] = frame[i * stride + 1];
+            }
+        }
+        std::memcpy(trace.is_right.data(), hands, n);
+        classify_raised_fingers_batch(trace, out);
+    }
+    return masks;
+}
+
+}  // namespace
+
+PYBIND11_MODULE(virtual_touch_cc, m) {
+    m.doc() = "virtual_touch C++ 파이프라인 바인딩";
+
+    py::class_<VirtualTouchOptions>(m, "Options")
+        .def(py::init<>())
+        .def_readwrite("camera_width", &VirtualTouchOptions::camera_width)
+        .def_readwrite("camera_height", &VirtualTouchOptions::camera_height)
+        .def_readwrite("camera_fps", &VirtualTouchOptions::camera_fps)
+        .def_readwrite("source", &VirtualTouchOptions::source)
+        .def_readwrite("decode_threads", &VirtualTouchOptions::decode_threads)
+        .def_readwrite("decode_frame_threading", &VirtualTouchOptions::decode_frame_threading)
+        .def_readwrite("convert_threads", &VirtualTouchOptions::convert_threads)
+        .def_readwrite("use_gpu", &VirtualTouchOptions::use_gpu)
+        .def_readwrite("model_path", &VirtualTouchOptions::model_path)
+        .def_readwrite("inject_mouse", &VirtualTouchOptions::inject_mouse)
+        .def_readwrite("show_preview", &VirtualTouchOptions::show_preview)
+        .def_readwrite("preview_max_fps", &VirtualTouchOptions::preview_max_fps)
+        .def_readwrite("preview_scale", &VirtualTouchOptions::preview_scale)
+        .def_readwrite("preview_backend", &VirtualTouchOptions::preview_backend)
+        .def_readwrite("idle_timeout_sec", &VirtualTouchOptions::idle_timeout_sec)
+        .def_readwrite("idle_inference_interval", &VirtualTouchOptions::idle_inference_interval)
+        .def_readwrite("landmark_bus_name", &VirtualTouchOptions::landmark_bus_name)
+        .def_readwrite("max_in_flight", &VirtualTouchOptions::max_in_flight)
+        .def_readwrite("roi_tracking", &VirtualTouchOptions::roi_tracking)
+        .def_readwrite("roi_margin", &VirtualTouchOptions::roi_margin)
+        .def_readwrite("roi_full_frame_interval", &VirtualTouchOptions::roi_full_frame_interval);
+
+    py::class_<PyPipeline>(m, "Pipeline")
+        .def(py::init<const VirtualTouchOptions&>(), py::arg("options") = VirtualTouchOptions())
+        .def("setup", &PyPipeline::setup, py::call_guard<py::gil_scoped_release>())
+        .def("run", &PyPipeline::run, py::call_guard<py::gil_scoped_release>())
+        .def("start", &PyPipeline::start)
+        .def("stop", &PyPipeline::stop, py::call_guard<py::gil_scoped_release>())
+        .def("landmarks", &PyPipeline::landmarks)
+        .def_property_readonly("hand_label", &PyPipeline::hand_label)
+        .def_property_readonly("timestamp_ms", &PyPipeline::timestamp_ms)
+        .def_property_readonly("frames_submitted", &PyPipeline::frames_submitted)
+        .def_property_readonly("results_received", &PyPipeline::results_received)
+        .def_property_readonly("frames_rejected", &PyPipeline::frames_rejected)
+        .def_property_readonly("frames_dropped_in_graph", &PyPipeline::frames_dropped_in_graph);
+
+    m.def("classify_fingers", &classify_fingers, py::arg("landmarks"), py::arg("is_right"),
+          "(N, 21, 3) 랜드마크의 손가락 마스크 (bit 0: 엄지 ... bit 4: 소지)");
+}
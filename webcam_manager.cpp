@@ -1,39 +1,69 @@
 #include "webcam_manager.h"
+#include <algorithm>
 #include <iostream>
 #include <chrono> // chrono 라이브러리 포함
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
 
 extern "C" {
 #include <libavformat/avformat.h>
 #include <libavcodec/avcodec.h>
-#include <libswscale/swscale.h>
-#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
 #include <libavdevice/avdevice.h>
 }
 
-WebcamManager::WebcamManager(int width, int height, int fps)
-    : width_(width), height_(height), fps_(fps) {}
+WebcamManager::WebcamManager(int width, int height, int fps, const std::string& source,
+                             const DecodeOptions& decode_options)
+    : width_(width), height_(height), fps_(fps), source_(source), decode_options_(decode_options) {
+    is_live_ = source_.rfind("/dev/video", 0) == 0;
+}
 
 WebcamManager::~WebcamManager() {
-    av_frame_free(&rgb_frame_);
+    if (poll_fd_ >= 0) close(poll_fd_);
     av_frame_free(&frame_);
     av_packet_free(&pkt_);
-    sws_freeContext(sws_ctx_);
     avcodec_free_context(&codec_ctx_);
     avformat_close_input(&fmt_ctx_);
 }
 
+int WebcamManager::open_poll_fd() const {
+    // libavdevice 는 장치 fd 를 공개하지 않으므로 같은 장치를 따로 하나 더 열어 poll 용으로만 씁니다.
+    // videobuf2 의 poll 은 큐 전체의 완료 버퍼를 보므로, 스트리밍 중인 fd 가 아니어도 프레임이 도착하면 읽기 가능해집니다.
+    // 영상 캡처 + 스트리밍 장치가 아니면(다른 종류의 문자 장치 등) -1 을 돌려주고 fd 없이 동작합니다.
+    int fd = open(source_.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    v4l2_capability capability{};
+    if (ioctl(fd, VIDIOC_QUERYCAP, &capability) != 0) {
+        close(fd);
+        return -1;
+    }
+    const uint32_t caps = (capability.capabilities & V4L2_CAP_DEVICE_CAPS) ? capability.device_caps : capability.capabilities;
+    if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
 bool WebcamManager::initialize() {
     avdevice_register_all();
-    const char* dev_name = "/dev/video0";
-    const AVInputFormat* inputFormat = av_find_input_format("v4l2");
+    const AVInputFormat* inputFormat = nullptr;
     
     AVDictionary* options = nullptr;
-    std::string video_size = std::to_string(width_) + "x" + std::to_string(height_);
-    av_dict_set(&options, "video_size", video_size.c_str(), 0);
-    av_dict_set(&options, "framerate", std::to_string(fps_).c_str(), 0);
+    if (is_live_) {
+        inputFormat = av_find_input_format("v4l2");
+        std::string video_size = std::to_string(width_) + "x" + std::to_string(height_);
+        av_dict_set(&options, "video_size", video_size.c_str(), 0);
+        av_dict_set(&options, "framerate", std::to_string(fps_).c_str(), 0);
+    }
 
-    if (avformat_open_input(&fmt_ctx_, dev_name, inputFormat, &options) != 0) {
-        std::cerr << "❌ 웹캠 연결 실패!" << std::endl; return false;
+    int open_result = avformat_open_input(&fmt_ctx_, source_.c_str(), inputFormat, &options);
+    av_dict_free(&options);
+    if (open_result != 0) {
+        std::cerr << "❌ 웹캠 연결 실패! (" << source_ << ")" << std::endl; return false;
     }
     if (avformat_find_stream_info(fmt_ctx_, nullptr) < 0) {
         std::cerr << "⚠️ 스트림 정보 읽기 실패!" << std::endl; return false;
@@ -48,41 +78,170 @@ bool WebcamManager::initialize() {
     const AVCodec* codec = avcodec_find_decoder(codecpar->codec_id);
     codec_ctx_ = avcodec_alloc_context3(codec);
     avcodec_parameters_to_context(codec_ctx_, codecpar);
+    // 코덱이 지원하는 스레딩 방식만 실제로 켜집니다. (active_thread_type)
+    codec_ctx_->thread_count = decode_options_.decode_threads;
+    codec_ctx_->thread_type = FF_THREAD_SLICE | (decode_options_.frame_threading ? FF_THREAD_FRAME : 0);
     if (avcodec_open2(codec_ctx_, codec, nullptr) < 0) {
         std::cerr << "⛔ 코덱 초기화 실패!" << std::endl; return false;
     }
 
+    const AVCodecDescriptor* descriptor = avcodec_descriptor_get(codec_ctx_->codec_id);
+    intra_only_ = descriptor && (descriptor->props & AV_CODEC_PROP_INTRA_ONLY);
+
+    if (is_live_) {
+        poll_fd_ = open_poll_fd();
+        if (poll_fd_ < 0) {
+            std::cerr << "⚠️ v4l2 장치를 기다릴 fd 를 열지 못했습니다. 캡처를 기다리는 동안 루프가 블록됩니다." << std::endl;
+        }
+    } else {
+        // 리플레이 파일은 녹화 해상도를 그대로 사용합니다.
+        width_ = codec_ctx_->width;
+        height_ = codec_ctx_->height;
+    }
+
     pkt_ = av_packet_alloc();
     frame_ = av_frame_alloc();
-    rgb_frame_ = av_frame_alloc();
-    
-    buffer_.resize(av_image_get_buffer_size(AV_PIX_FMT_RGB24, width_, height_, 1));
-    av_image_fill_arrays(rgb_frame_->data, rgb_frame_->linesize, buffer_.data(), AV_PIX_FMT_RGB24, width_, height_, 1);
-    
-    sws_ctx_ = sws_getContext(width_, height_, codec_ctx_->pix_fmt, width_, height_, AV_PIX_FMT_RGB24, SWS_BILINEAR, nullptr, nullptr, nullptr);
-    
+
+    if (!converter_.initialize(width_, height_, codec_ctx_->pix_fmt, decode_options_.convert_threads)) return false;
+
+    const char* thread_mode = codec_ctx_->active_thread_type == FF_THREAD_FRAME   ? "frame"
+                              : codec_ctx_->active_thread_type == FF_THREAD_SLICE ? "slice"
+                                                                                  : "없음";
+    std::cout << "🎞️ " << width_ << "x" << height_ << " " << codec->name << " (" << av_get_pix_fmt_name(codec_ctx_->pix_fmt)
+              << "), 디코딩 스레드 " << codec_ctx_->thread_count << " (" << thread_mode << "), 변환 띠 "
+              << converter_.num_slices() << std::endl;
     return true;
 }
 
-bool WebcamManager::get_next_frame(cv::Mat& out_frame) {
-    if (av_read_frame(fmt_ctx_, pkt_) >= 0) { 
+bool WebcamManager::grab() {
+    decoded_ahead_ = false;
+    if (draining_) return !at_end_;
+    while (av_read_frame(fmt_ctx_, pkt_) >= 0) {
+        if (pkt_->stream_index == video_stream_index_) return true;
+        av_packet_unref(pkt_);
+    }
+    // 장치는 일시적인 오류일 수 있으므로 계속 시도합니다.
+    if (is_live_) return false;
 
-        if (pkt_->stream_index == video_stream_index_) {
-            if (avcodec_send_packet(codec_ctx_, pkt_) == 0) {
-                if (avcodec_receive_frame(codec_ctx_, frame_) == 0) {
+    // 리플레이 파일이 끝났습니다. 디코더에 남아 있는 프레임(프레임 스레딩/B 프레임 지연분)을 마저 꺼냅니다.
+    draining_ = avcodec_send_packet(codec_ctx_, nullptr) == 0;
+    at_end_ = !draining_;
+    return draining_;
+}
 
-                    sws_scale(sws_ctx_, frame_->data, frame_->linesize, 0, height_, rgb_frame_->data, rgb_frame_->linesize);
+// pkt_ 를 디코더에 넣고 나온 프레임을 frame_ 에 받습니다. (드레인 중에는 남은 프레임만 꺼냅니다)
+// 프레임 스레딩이면 처음 몇 패킷은 프레임 없이 false 를 반환합니다.
+bool WebcamManager::decode_next() {
+    const bool sent = draining_ || avcodec_send_packet(codec_ctx_, pkt_) == 0;
+    av_packet_unref(pkt_);
+    if (!sent) return false;
 
-                    cv::Mat rgb_mat(height_, width_, CV_8UC3, rgb_frame_->data[0], rgb_frame_->linesize[0]);
-                    rgb_mat.copyTo(out_frame);                   
-                   
-                    av_packet_unref(pkt_);
-                   
-                    return true;
-                }
-            }
-        }
+    if (avcodec_receive_frame(codec_ctx_, frame_) != 0) {
+        if (draining_) at_end_ = true;
+        return false;
+    }
+    last_frame_timestamp_ms_ = to_ms(frame_->best_effort_timestamp);
+    return true;
+}
+
+// peek_timestamp_ms() 가 미리 디코딩한 프레임이 있으면 그것을, 없으면 pkt_ 를 디코딩해서 씁니다.
+bool WebcamManager::take_decoded() {
+    if (decoded_ahead_) {
+        decoded_ahead_ = false;
+        return true;
+    }
+    return decode_next();
+}
+
+bool WebcamManager::peek_timestamp_ms(int64_t& timestamp_ms) {
+    if (decoded_ahead_) {
+        timestamp_ms = last_frame_timestamp_ms_;
+        return true;
+    }
+    // intra-only 코덱은 재정렬이 없으므로 패킷 시각이 곧 프레임 시각입니다.
+    if (intra_only_ && !draining_ && pkt_->pts != AV_NOPTS_VALUE) {
+        timestamp_ms = to_ms(pkt_->pts);
+        return true;
+    }
+    if (!decode_next()) return false;
+    decoded_ahead_ = true;
+    timestamp_ms = last_frame_timestamp_ms_;
+    return true;
+}
+
+bool WebcamManager::retrieve(cv::Mat& out_frame) {
+    if (!take_decoded()) return false;
+
+    // 호출하는 쪽의 Mat 에 바로 변환합니다. (크기가 같으면 create() 는 재할당하지 않습니다)
+    out_frame.create(height_, width_, CV_8UC3);
+    converter_.convert(frame_, out_frame.data, static_cast<int>(out_frame.step));
+    return true;
+}
+
+bool WebcamManager::retrieve_region(cv::Rect& roi, cv::Mat& out_frame) {
+    if (!converter_.supports_region()) return FrameSource::retrieve_region(roi, out_frame);
+    if (!take_decoded()) return false;
+
+    // 시작 위치는 색차 한 칸 단위로 내리고, 끝 위치는 올려서 영역이 줄어들지 않게 합니다.
+    const int align_x = converter_.x_alignment();
+    const int align_y = converter_.y_alignment();
+    roi &= cv::Rect(0, 0, width_, height_);
+    const int x0 = roi.x / align_x * align_x;
+    const int y0 = roi.y / align_y * align_y;
+    const int x1 = std::min(width_, (roi.x + roi.width + align_x - 1) / align_x * align_x);
+    const int y1 = std::min(height_, (roi.y + roi.height + align_y - 1) / align_y * align_y);
+    roi = cv::Rect(x0, y0, x1 - x0, y1 - y0);
+
+    out_frame.create(roi.height, roi.width, CV_8UC3);
+    return converter_.convert_region(frame_, roi.x, roi.y, roi.width, roi.height, out_frame.data,
+                                     static_cast<int>(out_frame.step));
+}
+
+bool WebcamManager::discard() {
+    if (decoded_ahead_) {
+        decoded_ahead_ = false;
+        return true;
+    }
+    if (intra_only_ && !draining_) {
+        // 다음 프레임이 이 프레임을 참조하지 않으므로 패킷만 버려도 됩니다.
+        last_frame_timestamp_ms_ = to_ms(pkt_->pts);
         av_packet_unref(pkt_);
+        return true;
+    }
+    // 참조 프레임이 깨지지 않도록 디코딩은 하되 변환은 하지 않습니다.
+    return decode_next();
+}
+
+int64_t WebcamManager::to_ms(int64_t stream_timestamp) const {
+    if (stream_timestamp == AV_NOPTS_VALUE) return -1;
+    const AVStream* stream = fmt_ctx_->streams[video_stream_index_];
+    int64_t start = stream->start_time == AV_NOPTS_VALUE ? 0 : stream->start_time;
+    return av_rescale_q(stream_timestamp - start, stream->time_base, AVRational{1, 1000});
+}
+
+int64_t WebcamManager::duration_ms() const {
+    const AVStream* stream = fmt_ctx_->streams[video_stream_index_];
+    if (stream->duration != AV_NOPTS_VALUE) {
+        return av_rescale_q(stream->duration, stream->time_base, AVRational{1, 1000});
+    }
+    return fmt_ctx_->duration == AV_NOPTS_VALUE ? -1 : fmt_ctx_->duration / (AV_TIME_BASE / 1000);
+}
+
+bool WebcamManager::seek_ms(int64_t timestamp_ms) {
+    if (is_live_) return false;
+    const AVStream* stream = fmt_ctx_->streams[video_stream_index_];
+    int64_t start = stream->start_time == AV_NOPTS_VALUE ? 0 : stream->start_time;
+    int64_t target = start + av_rescale_q(timestamp_ms, AVRational{1, 1000}, stream->time_base);
+
+    // 목표 시각 직전의 키프레임으로 이동합니다. 목표 이전 프레임은 호출하는 쪽에서 discard() 로 넘깁니다.
+    if (av_seek_frame(fmt_ctx_, video_stream_index_, target, AVSEEK_FLAG_BACKWARD) < 0) {
+        std::cerr << "⚠️ 탐색 실패! (" << source_ << ", " << timestamp_ms << "ms)" << std::endl;
+        return false;
     }
-    return false;
+    avcodec_flush_buffers(codec_ctx_);
+    at_end_ = false;
+    draining_ = false;
+    decoded_ahead_ = false;
+    last_frame_timestamp_ms_ = -1;
+    return true;
 }
\ No newline at end of file
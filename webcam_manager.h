@@ -1,37 +1,82 @@
 #pragma once
 #include <opencv2/opencv.hpp>
 #include <string>
+#include "frame_source.h"
+#include "sliced_rgb_converter.h"
 
 // FFmpeg 헤더 전방 선언
 struct AVFormatContext;
 struct AVCodecContext;
-struct SwsContext;
 struct AVFrame;
 struct AVPacket;
 struct AVInputFormat;
 
-class WebcamManager {
+// 디코딩/색 변환 스레드 설정 (1080p 이상 카메라나 고해상도 녹화 파일용)
+struct DecodeOptions {
+    // 디코더 스레드 수. 0 이면 FFmpeg 가 코어 수에 맞춰 정하고, 1 이면 스레드를 쓰지 않습니다.
+    int decode_threads = 1;
+    // 슬라이스 스레딩은 지연이 없지만 코덱이 슬라이스를 나눠 인코딩했을 때만 효과가 있습니다.
+    // 프레임 스레딩은 처리량이 크게 늘지만 출력이 (스레드 수 - 1) 프레임 늦어집니다.
+    bool frame_threading = false;
+    // RGB 변환을 나눌 가로 띠 수 (= 변환 스레드 수)
+    int convert_threads = 1;
+};
+
+class WebcamManager : public FrameSource {
 public:
-    WebcamManager(int width, int height, int fps);
-    ~WebcamManager();
+    // source 가 "/dev/video*" 이면 v4l2 장치로, 그 외에는 녹화 파일(리플레이)로 엽니다.
+    WebcamManager(int width, int height, int fps, const std::string& source = "/dev/video0",
+                  const DecodeOptions& decode_options = {});
+    ~WebcamManager() override;
+
+    bool initialize() override;
+
+    // grab() 으로 다음 비디오 패킷을 받은 뒤, 쓸 프레임인지 판단하고 나서 변환 여부를 정할 수 있습니다.
+    bool grab() override;
+    bool retrieve(cv::Mat& frame) override;
+    // 디코딩은 전체를 하지만 RGB 변환은 roi 영역만 합니다. (roi 는 색차 서브샘플링 단위로 넓혀집니다)
+    bool retrieve_region(cv::Rect& roi, cv::Mat& frame) override;
+    // RGB 변환 없이 버립니다. (MJPEG 처럼 intra-only 코덱이면 디코딩도 생략)
+    bool discard() override;
 
-    bool initialize();
-    bool get_next_frame(cv::Mat& frame);
+    int get_width() const override { return width_; }
+    int get_height() const override { return height_; }
+    bool is_live() const override { return is_live_; }
+    bool at_end() const override { return at_end_; }
+    int get_poll_fd() const override { return poll_fd_; }
 
-    int get_width() const { return width_; }
-    int get_height() const { return height_; }
+    // 리플레이 파일 전용: 전체 길이, 탐색, 마지막으로 디코딩한 프레임의 표시 시각 (모두 ms)
+    int64_t duration_ms() const;
+    bool seek_ms(int64_t timestamp_ms);
+    int64_t last_frame_timestamp_ms() const { return last_frame_timestamp_ms_; }
+    // grab() 한 프레임의 표시 시각을 RGB 변환 전에 알려 줍니다. intra-only 코덱이면 패킷 시각만 보고,
+    // 아니면 여기서 디코딩까지 합니다. 이어서 retrieve() 는 변환만, discard() 는 버리기만 합니다.
+    // (프레임 스레딩 지연으로 아직 나온 프레임이 없으면 false)
+    bool peek_timestamp_ms(int64_t& timestamp_ms);
 
 private:
     int width_;
     int height_;
     int fps_;
-    
+    std::string source_;
+    DecodeOptions decode_options_;
+    bool is_live_ = true;
+    bool at_end_ = false;
+    bool draining_ = false;  // 파일 끝: 디코더에 남은 프레임을 꺼내는 중
+    int poll_fd_ = -1;       // poll 전용으로 따로 연 v4l2 장치 fd (리플레이 파일이면 -1)
+    bool intra_only_ = false;
+    int64_t last_frame_timestamp_ms_ = -1;
+    bool decoded_ahead_ = false;  // peek_timestamp_ms() 가 frame_ 에 미리 디코딩해 둠
+
+    int open_poll_fd() const;
+    int64_t to_ms(int64_t stream_timestamp) const;
+    bool decode_next();
+    bool take_decoded();
+
     AVFormatContext* fmt_ctx_ = nullptr;
     AVCodecContext* codec_ctx_ = nullptr;
-    SwsContext* sws_ctx_ = nullptr;
+    SlicedRgbConverter converter_;
     AVFrame* frame_ = nullptr;
-    AVFrame* rgb_frame_ = nullptr;
     AVPacket* pkt_ = nullptr;
     int video_stream_index_ = -1;
-    std::vector<uint8_t> buffer_;
 };
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "xshm_window.h"
+#include <cerrno>
+#include <chrono>
+#include <iostream>
+#include <poll.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/keysym.h>
+#include <X11/extensions/XShm.h>
+
+struct XShmWindow::Segment {
+    XShmSegmentInfo info{};
+};
+
+namespace {
+// XShmAttach 동안만 설치하는 오류 핸들러. 붙이는 디스플레이의 오류만 잡고 나머지는 원래 핸들러로 넘깁니다.
+Display* g_trap_display = nullptr;
+XErrorHandler g_previous_error_handler = nullptr;
+bool g_trapped_error = false;
+
+int trap_error(Display* display, XErrorEvent* error) {
+    if (display == g_trap_display) {
+        g_trapped_error = true;
+        return 0;
+    }
+    return g_previous_error_handler ? g_previous_error_handler(display, error) : 0;
+}
+}  // namespace
+
+XShmWindow::~XShmWindow() {
+    if (!display_) return;
+    if (attached_) wait_for_present();
+    if (!responsive_) {
+        // 서버가 응답하지 않으면 XSync/XCloseDisplay 가 끝나지 않으므로 우리 쪽 자원만 정리합니다.
+        // (세그먼트는 이미 IPC_RMID 표시가 되어 있어 서버가 떼거나 끝나면 사라집니다)
+        std::cerr << "⚠️ 미리보기: X 서버가 응답하지 않아 창 정리를 건너뜁니다." << std::endl;
+        if (segment_ && segment_->info.shmaddr) shmdt(segment_->info.shmaddr);
+        return;
+    }
+    if (attached_) {
+        XShmDetach(display_, &segment_->info);
+        XSync(display_, False);
+    }
+    if (segment_ && segment_->info.shmaddr) shmdt(segment_->info.shmaddr);
+    if (image_) {
+        image_->data = nullptr;  // 공유 메모리는 위에서 떼었으므로 XDestroyImage 가 free 하지 않게 합니다.
+        XDestroyImage(image_);
+    }
+    if (gc_) XFreeGC(display_, gc_);
+    if (window_) XDestroyWindow(display_, window_);
+    XCloseDisplay(display_);
+}
+
+bool XShmWindow::initialize(int width, int height, const std::string& title) {
+    display_ = XOpenDisplay(nullptr);
+    if (!display_) {
+        std::cerr << "⚠️ 미리보기: X 서버에 연결할 수 없습니다!" << std::endl;
+        return false;
+    }
+    if (!XShmQueryExtension(display_)) {
+        std::cerr << "⚠️ 미리보기: MIT-SHM 을 쓸 수 없는 X 서버입니다. (원격 디스플레이?)" << std::endl;
+        return false;
+    }
+
+    // BGRA 로 바로 쓸 수 있는 32bpp TrueColor (빨강이 상위 바이트) 만 지원합니다.
+    const int screen = DefaultScreen(display_);
+    XVisualInfo visual_info;
+    if (!XMatchVisualInfo(display_, screen, 24, TrueColor, &visual_info) || visual_info.red_mask != 0xff0000 ||
+        visual_info.green_mask != 0x00ff00 || visual_info.blue_mask != 0x0000ff) {
+        std::cerr << "⚠️ 미리보기: 24비트 TrueColor 화면이 아닙니다." << std::endl;
+        return false;
+    }
+
+    segment_ = std::make_unique<Segment>();
+    image_ = XShmCreateImage(display_, visual_info.visual, 24, ZPixmap, nullptr, &segment_->info, width, height);
+    if (!image_ || image_->bits_per_pixel != 32) {
+        std::cerr << "⚠️ 미리보기: 32bpp 공유 이미지를 만들 수 없습니다." << std::endl;
+        return false;
+    }
+
+    segment_->info.shmid = shmget(IPC_PRIVATE, static_cast<size_t>(image_->bytes_per_line) * height, IPC_CREAT | 0600);
+    if (segment_->info.shmid < 0) {
+        std::cerr << "⚠️ 미리보기: 공유 메모리 할당 실패!" << std::endl;
+        return false;
+    }
+    segment_->info.shmaddr = image_->data = static_cast<char*>(shmat(segment_->info.shmid, nullptr, 0));
+    if (segment_->info.shmaddr == reinterpret_cast<char*>(-1)) {
+        segment_->info.shmaddr = image_->data = nullptr;
+        shmctl(segment_->info.shmid, IPC_RMID, nullptr);
+        std::cerr << "⚠️ 미리보기: 공유 메모리 연결 실패!" << std::endl;
+        return false;
+    }
+    segment_->info.readOnly = False;
+    // 포워딩/원격 디스플레이(ssh -X 등)는 MIT-SHM 을 알려도 XSync 때 BadAccess 로 붙이기가 실패합니다.
+    // Xlib 기본 오류 핸들러는 프로세스를 끝내므로, 붙이는 동안만 오류를 잡아 false 를 돌려주고
+    // PreviewRenderer 가 highgui 로 돌아가게 합니다.
+    XSync(display_, False);
+    g_trap_display = display_;
+    g_trapped_error = false;
+    g_previous_error_handler = XSetErrorHandler(trap_error);
+    attached_ = XShmAttach(display_, &segment_->info);
+    XSync(display_, False);
+    if (g_trapped_error && attached_) {
+        XShmDetach(display_, &segment_->info);
+        XSync(display_, False);
+        attached_ = false;
+    }
+    XSetErrorHandler(g_previous_error_handler);
+    g_trap_display = nullptr;
+    // 서버까지 붙은 뒤 삭제 표시를 해 두면 프로세스가 비정상 종료해도 세그먼트가 남지 않습니다.
+    shmctl(segment_->info.shmid, IPC_RMID, nullptr);
+    if (!attached_) {
+        std::cerr << "⚠️ 미리보기: X 서버가 공유 메모리를 붙이지 못했습니다. (원격 디스플레이?)" << std::endl;
+        return false;
+    }
+
+    window_ = XCreateSimpleWindow(display_, RootWindow(display_, screen), 0, 0, width, height, 0,
+                                  BlackPixel(display_, screen), BlackPixel(display_, screen));
+    XStoreName(display_, window_, title.c_str());
+    XSelectInput(display_, window_, KeyPressMask | StructureNotifyMask);
+    wm_delete_window_ = XInternAtom(display_, "WM_DELETE_WINDOW", False);
+    XSetWMProtocols(display_, window_, &wm_delete_window_, 1);
+    gc_ = XCreateGC(display_, window_, 0, nullptr);
+    XMapWindow(display_, window_);
+
+    completion_event_type_ = XShmGetEventBase(display_) + ShmCompletion;
+    XSync(display_, False);
+
+    width_ = width;
+    height_ = height;
+    return true;
+}
+
+uint8_t* XShmWindow::pixels() const {
+    return reinterpret_cast<uint8_t*>(image_->data);
+}
+
+int XShmWindow::stride() const {
+    return image_->bytes_per_line;
+}
+
+bool XShmWindow::wait_for_present(int timeout_ms) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (present_pending_) {
+        if (XPending(display_) > 0) {
+            XEvent event;
+            XNextEvent(display_, &event);
+            handle_event(event);
+            continue;
+        }
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        pollfd pfd{ConnectionNumber(display_), POLLIN, 0};
+        if (remaining <= 0 || (poll(&pfd, 1, static_cast<int>(remaining)) < 0 && errno != EINTR)) {
+            present_pending_ = false;
+            responsive_ = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+void XShmWindow::present() {
+    // send_event=True: 서버가 공유 메모리를 다 읽으면 ShmCompletion 이벤트가 옵니다.
+    XShmPutImage(display_, window_, gc_, image_, 0, 0, 0, 0, width_, height_, True);
+    XFlush(display_);
+    present_pending_ = true;
+}
+
+bool XShmWindow::process_events() {
+    while (XPending(display_) > 0) {
+        XEvent event;
+        XNextEvent(display_, &event);
+        handle_event(event);
+    }
+    return quit_;
+}
+
+void XShmWindow::handle_event(const _XEvent& event) {
+    if (event.type == completion_event_type_) {
+        present_pending_ = false;
+        responsive_ = true;
+    } else if (event.type == KeyPress) {
+        XKeyEvent key = event.xkey;
+        if (XLookupKeysym(&key, 0) == XK_q) quit_ = true;
+    } else if (event.type == ClientMessage &&
+               static_cast<unsigned long>(event.xclient.data.l[0]) == wm_delete_window_) {
+        quit_ = true;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Xlib 헤더 전방 선언 (Status, None 같은 매크로가 다른 헤더로 새지 않도록)
+struct _XDisplay;
+struct _XGC;
+struct _XImage;
+union _XEvent;
+
+// MIT-SHM 으로 그리는 미리보기 창.
+// 픽셀 버퍼가 X 서버와 공유하는 메모리이므로 여기에 바로 그리고 present() 하면 소켓으로 픽셀을 보내지 않습니다.
+// 모든 호출은 한 스레드(미리보기 렌더 스레드)에서 해야 합니다.
+class XShmWindow {
+public:
+    XShmWindow() = default;
+    ~XShmWindow();
+
+    XShmWindow(const XShmWindow&) = delete;
+    XShmWindow& operator=(const XShmWindow&) = delete;
+
+    // 창과 공유 이미지를 만듭니다. 로컬 X 서버가 아니거나(MIT-SHM 없음) 32bpp TrueColor 가 아니면 false.
+    bool initialize(int width, int height, const std::string& title);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // BGRA 픽셀 버퍼 (한 줄 stride() 바이트). 이전 present() 가 서버에서 끝나기 전에는 쓰지 않도록
+    // 먼저 wait_for_present() 를 부릅니다.
+    uint8_t* pixels() const;
+    int stride() const;
+
+    // 이전 present() 의 완료 이벤트를 기다립니다. (보통 이미 끝나 있어 바로 반환)
+    // X 연결 fd 를 poll 하며 최대 timeout_ms 까지만 기다립니다. 완료 이벤트가 오지 않으면(서버 멈춤, 이벤트 유실)
+    // 포기하고 false 를 돌려주며, 이후 소멸자는 서버 응답이 필요한 정리를 건너뜁니다.
+    static const int kPresentTimeoutMs = 500;
+    bool wait_for_present(int timeout_ms = kPresentTimeoutMs);
+    // 공유 이미지를 창에 올립니다. 완료는 비동기로 알림 받습니다.
+    void present();
+
+    // 쌓인 창 이벤트를 처리합니다. 'q' 키나 창 닫기면 true.
+    bool process_events();
+
+private:
+    struct Segment;  // XShmSegmentInfo (익명 구조체라 전방 선언이 안 되어 감쌉니다)
+
+    void handle_event(const _XEvent& event);
+
+    _XDisplay* display_ = nullptr;
+    unsigned long window_ = 0;
+    _XGC* gc_ = nullptr;
+    _XImage* image_ = nullptr;
+    std::unique_ptr<Segment> segment_;  // 이미지가 살아 있는 동안 유지 (XImage::obdata 가 가리킴)
+    unsigned long wm_delete_window_ = 0;
+    bool attached_ = false;
+    int completion_event_type_ = -1;
+    bool present_pending_ = false;
+    bool responsive_ = true;  // 완료 이벤트를 제한 시간 안에 받았는지 (false 면 소멸자에서 XSync 등을 하지 않음)
+    bool quit_ = false;
+    int width_ = 0;
+    int height_ = 0;
+};